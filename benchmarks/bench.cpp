@@ -0,0 +1,654 @@
+#include <golomb.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Order used by all benchmarks
+constexpr size_t bench_k = 3u;
+
+// Filter shift used by the adaptive benchmarks
+constexpr size_t bench_shift = 2u;
+
+// Number of times each benchmark runs, the fastest run is reported
+constexpr int bench_runs = 5;
+
+// Number of times the golomb utility runs per performance test, the fastest run is reported
+constexpr int perf_runs = 3;
+
+static size_t       n_values = 1u << 20;
+static const char * filter   = nullptr;
+static int          failures = 0;
+
+// Options of the performance tests of the golomb utility
+static const char * baseline_path   = nullptr;
+static size_t       corpus_bytes    = 256u << 20;
+static double       threshold       = 10.0;     // Percentage of throughput that the tests may drop below the baseline
+static bool         update_baseline = false;
+
+// Synthetic data
+
+enum class distribution
+{
+    geometric,  // Small values, large values are exponentially less likely
+    laplacian,  // Geometric magnitudes with a random sign, centered around mid range for unsigned types
+    uniform,    // Every value of the type is equally likely
+    sparse      // Mostly very small values with 1% uniformly distributed outliers
+};
+
+static const char * name( distribution dist )
+{
+    switch( dist )
+    {
+        case distribution::geometric: return "geometric";
+        case distribution::laplacian: return "laplacian";
+        case distribution::uniform:   return "uniform";
+        case distribution::sparse:    return "sparse";
+    }
+
+    return "?";
+}
+
+template< std::integral ValueT >
+static std::vector< ValueT > generate( distribution dist )
+{
+    using UnsignedValueT = typename std::make_unsigned< ValueT >::type;
+
+    constexpr auto mid_range = static_cast< UnsignedValueT >( static_cast< UnsignedValueT >( ~UnsignedValueT{} ) / 2u + 1u );
+
+    std::mt19937_64                              random( 1003u );
+    std::geometric_distribution< uint64_t >      magnitude( 1.0 / ( 1u << ( bench_k + 1u ) ) );
+    std::uniform_int_distribution< uint64_t >    bits;
+    std::bernoulli_distribution                  outlier( 0.01 );
+
+    const auto uniform_value = [ & ]() { return static_cast< ValueT >( bits( random ) ); };
+    const auto small_value   = [ & ]()
+    {
+        return static_cast< UnsignedValueT >( std::min< uint64_t >( magnitude( random ), std::numeric_limits< ValueT >::max() ) );
+    };
+
+    std::vector< ValueT > values( n_values );
+    for( auto & value : values )
+    {
+        switch( dist )
+        {
+            case distribution::geometric:
+                value = static_cast< ValueT >( small_value() );
+                break;
+            case distribution::laplacian:
+            {
+                const auto m = small_value();
+                if constexpr( std::is_signed_v< ValueT > )
+                {
+                    value = static_cast< ValueT >( bits( random ) & 1u ? -static_cast< ValueT >( m ) : static_cast< ValueT >( m ) );
+                }
+                else
+                {
+                    value = static_cast< ValueT >( bits( random ) & 1u ? mid_range - m : mid_range + m );
+                }
+                break;
+            }
+            case distribution::uniform:
+                value = uniform_value();
+                break;
+            case distribution::sparse:
+                value = outlier( random ) ? uniform_value() : static_cast< ValueT >( bits( random ) & 0x03u );
+                break;
+        }
+    }
+
+    return values;
+}
+
+// Measurement
+
+template< typename FunctionT >
+static double measure( const FunctionT & function )
+{
+    auto best = std::numeric_limits< double >::max();
+    for( int run = 0 ; run < bench_runs ; ++run )
+    {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const auto stop  = std::chrono::steady_clock::now();
+
+        best = std::min( best, std::chrono::duration< double >( stop - start ).count() );
+    }
+
+    return best;
+}
+
+static void report( const char * const operation, const char * const type, distribution dist,
+                    size_t value_size, size_t encoded_bytes, double seconds )
+{
+    const auto values_per_second = static_cast< double >( n_values ) / seconds;
+
+    std::printf( "%-14s %-4s %-10s %10.2f Mvalues/s %10.2f MB/s %8.3f bits/value\n",
+                 operation, type, name( dist ),
+                 values_per_second / 1e6,
+                 values_per_second * static_cast< double >( value_size ) / 1e6,
+                 8.0 * static_cast< double >( encoded_bytes ) / static_cast< double >( n_values ) );
+}
+
+template< typename ValueT >
+static void check( const char * const operation, const char * const type, distribution dist,
+                   const std::vector< ValueT > & expected, const std::vector< ValueT > & decoded )
+{
+    if( expected != decoded )
+    {
+        std::printf( ">>> %s %s %s decoded incorrect data!\n", operation, type, name( dist ) );
+        ++failures;
+    }
+}
+
+static bool selected( const char * const operation, const char * const type )
+{
+    return filter == nullptr
+        || std::string_view( operation ).find( filter ) != std::string_view::npos
+        || std::string_view( type ) == filter;
+}
+
+// Benchmarks
+
+template< typename ValueT >
+static void bench_encode( const char * const type, distribution dist, const std::vector< ValueT > & values )
+{
+    using EncoderT = pg::golomb::encoder< uint8_t * >;
+
+    constexpr auto max_codeword_bytes = ( 2u * std::numeric_limits< ValueT >::digits + 9u ) / 8u + 1u;
+
+    const std::span< const ValueT > input( values );
+    std::vector< uint8_t >          output( values.size() * max_codeword_bytes + 8u );
+    size_t                          size = {};
+
+    const auto run = [ & ]( const char * const operation, const auto & function )
+    {
+        if( selected( operation, type ) )
+        {
+            const auto seconds = measure( [ & ]() { size = static_cast< size_t >( function() - output.data() ); } );
+            report( operation, type, dist, sizeof( ValueT ), size, seconds );
+        }
+    };
+
+    run( "push<k>", [ & ]()
+    {
+        EncoderT e( output.data() );
+        for( const auto value : input )
+        {
+            e.template push< bench_k >( value );
+        }
+        return e.flush();
+    } );
+
+    run( "push(x, k)", [ & ]()
+    {
+        EncoderT e( output.data() );
+        for( const auto value : input )
+        {
+            e.push( value, bench_k );
+        }
+        return e.flush();
+    } );
+
+    run( "push_n", [ & ]()
+    {
+        EncoderT e( output.data() );
+        e.push_n( input, bench_k );
+        return e.flush();
+    } );
+
+    run( "encode", [ & ]()
+    {
+        return pg::golomb::encode( input, output.data(), bench_k );
+    } );
+
+    run( "adaptive enc", [ & ]()
+    {
+        return pg::golomb::adaptive_encode< bench_shift >( input, output.data(), bench_k );
+    } );
+
+    run( "attack/decay", [ & ]()
+    {
+        return pg::golomb::adaptive_encode( input, output.data(), pg::golomb::attack_decay_policy<>( bench_k ) );
+    } );
+
+    run( "optimal blocks", [ & ]()
+    {
+        std::vector< pg::golomb::block_info > index;
+        return pg::golomb::encode_optimal_blocks( input, output.data(), std::back_inserter( index ), 4096u ).first;
+    } );
+}
+
+template< typename ValueT >
+static void bench_decode( const char * const type, distribution dist, const std::vector< ValueT > & values )
+{
+    std::vector< uint8_t > encoded;
+    std::vector< uint8_t > adaptive_encoded;
+    std::vector< ValueT >  decoded( values.size() );
+
+    pg::golomb::encode( std::span< const ValueT >( values ), std::back_inserter( encoded ), bench_k );
+
+    pg::golomb::adaptive_encode< bench_shift >( std::span< const ValueT >( values ), std::back_inserter( adaptive_encoded ), bench_k );
+
+    const auto first = encoded.data();
+    const auto last  = encoded.data() + encoded.size();
+
+    const auto run = [ & ]( const char * const operation, size_t encoded_size, const auto & function )
+    {
+        if( selected( operation, type ) )
+        {
+            std::fill( decoded.begin(), decoded.end(), ValueT{} );
+            const auto seconds = measure( function );
+            report( operation, type, dist, sizeof( ValueT ), encoded_size, seconds );
+            check( operation, type, dist, values, decoded );
+        }
+    };
+
+    run( "pull<k>", encoded.size(), [ & ]()
+    {
+        pg::golomb::decoder d( first, last );
+        for( auto & value : decoded )
+        {
+            value = d.template pull< ValueT, bench_k >().value;
+        }
+    } );
+
+    run( "pull(k)", encoded.size(), [ & ]()
+    {
+        pg::golomb::decoder d( first, last );
+        for( auto & value : decoded )
+        {
+            value = d.template pull< ValueT >( bench_k ).value;
+        }
+    } );
+
+    run( "pull_n", encoded.size(), [ & ]()
+    {
+        pg::golomb::decoder d( first, last );
+        ( void )d.template pull_n< ValueT >( std::span< ValueT >( decoded ), bench_k );
+    } );
+
+    run( "decode", encoded.size(), [ & ]()
+    {
+        pg::golomb::decode< ValueT >( std::span< const uint8_t >( encoded ), decoded.data(), bench_k );
+    } );
+
+    run( "adaptive dec", adaptive_encoded.size(), [ & ]()
+    {
+        pg::golomb::adaptive_decode< ValueT, bench_shift >( std::span< const uint8_t >( adaptive_encoded ), decoded.data(), bench_k );
+    } );
+}
+
+template< typename ValueT >
+static void bench_type( const char * const type )
+{
+    for( const auto dist : { distribution::geometric, distribution::laplacian, distribution::uniform, distribution::sparse } )
+    {
+        const auto values = generate< ValueT >( dist );
+
+        bench_encode( type, dist, values );
+        bench_decode( type, dist, values );
+    }
+}
+
+// Performance tests of the golomb utility
+
+// Results of the performance tests by name, in MB/s of unencoded data
+using perf_results = std::vector< std::pair< std::string, double > >;
+
+// Reads the results of a baseline file that is written by 'write_results', returns false when the file doesn't exist.
+static bool read_results( const char * const path, perf_results & results )
+{
+    std::FILE * const file = std::fopen( path, "r" );
+    if( file == nullptr )
+    {
+        return false;
+    }
+
+    // Each line contains a "name": value pair
+    char line[ 256 ];
+    while( std::fgets( line, sizeof( line ), file ) )
+    {
+        const std::string_view text( line );
+
+        const auto first = text.find( '"' );
+        const auto last  = first == std::string_view::npos ? first : text.find( '"', first + 1u );
+        const auto colon = last == std::string_view::npos ? last : text.find( ':', last );
+        if( colon != std::string_view::npos )
+        {
+            results.emplace_back( std::string( text.substr( first + 1u, last - first - 1u ) ), std::strtod( line + colon + 1u, nullptr ) );
+        }
+    }
+
+    std::fclose( file );
+
+    return true;
+}
+
+static void write_results( const char * const path, const perf_results & results )
+{
+    std::FILE * const file = std::fopen( path, "w" );
+    if( file == nullptr )
+    {
+        std::perror( path );
+        ++failures;
+        return;
+    }
+
+    std::fprintf( file, "{\n" );
+    for( size_t i = 0u ; i < results.size() ; ++i )
+    {
+        std::fprintf( file, "    \"%s\": %.2f%s\n", results[ i ].first.c_str(), results[ i ].second, i + 1u < results.size() ? "," : "" );
+    }
+    std::fprintf( file, "}\n" );
+
+    std::fclose( file );
+}
+
+static bool write_file( const char * const path, const void * data, size_t size )
+{
+    std::FILE * const file = std::fopen( path, "wb" );
+    if( file == nullptr )
+    {
+        return false;
+    }
+
+    const bool written = std::fwrite( data, 1u, size, file ) == size;
+
+    return std::fclose( file ) == 0 && written;
+}
+
+static bool same_files( const char * const path_a, const char * const path_b )
+{
+    std::FILE * const a = std::fopen( path_a, "rb" );
+    std::FILE * const b = std::fopen( path_b, "rb" );
+
+    bool same = a && b;
+
+    std::vector< char > buffer_a( 1u << 20 );
+    std::vector< char > buffer_b( 1u << 20 );
+    while( same )
+    {
+        const auto size_a = std::fread( buffer_a.data(), 1u, buffer_a.size(), a );
+        const auto size_b = std::fread( buffer_b.data(), 1u, buffer_b.size(), b );
+
+        same = size_a == size_b && std::memcmp( buffer_a.data(), buffer_b.data(), size_a ) == 0;
+        if( size_a < buffer_a.size() )
+        {
+            break;
+        }
+    }
+
+    if( a )
+    {
+        std::fclose( a );
+    }
+    if( b )
+    {
+        std::fclose( b );
+    }
+
+    return same;
+}
+
+// Runs the golomb utility 'runs' times with 'options', returns the fastest time of the runs or nothing when a run failed.
+static std::optional< double > run_golomb( const std::string & options, const char * const input, const char * const output, int runs = perf_runs )
+{
+    const auto command = "./golomb " + options + " " + input + " " + output;
+
+    auto best = std::numeric_limits< double >::max();
+    for( int run = 0 ; run < runs ; ++run )
+    {
+        const auto start  = std::chrono::steady_clock::now();
+        const auto status = std::system( command.c_str() );
+        const auto stop   = std::chrono::steady_clock::now();
+
+        if( status != 0 )
+        {
+            std::printf( ">>> '%s' failed!\n", command.c_str() );
+            ++failures;
+            return {};
+        }
+
+        best = std::min( best, std::chrono::duration< double >( stop - start ).count() );
+    }
+
+    return best;
+}
+
+// Encodes and decodes a corpus of a data type and distribution with the golomb utility in the fixed order, adaptive,
+// block and parallel stream modes.
+template< typename ValueT >
+static void perf_type( const char * const type, perf_results & results )
+{
+    const auto jobs = " -j" + std::to_string( std::max( 1u, std::thread::hardware_concurrency() ) );
+    const auto p    = " -p" + std::to_string( std::max( 1u, std::thread::hardware_concurrency() ) );
+    const auto k    = " -k" + std::to_string( bench_k );
+    const auto a    = " -a" + std::to_string( bench_shift );
+
+    struct perf_case
+    {
+        const char * operation;
+        std::string  encode_options;
+        std::string  decode_options;
+        bool         timed_encode;      // False when the encoding is the same as of another test
+    };
+
+    const std::string e = std::string( "-e" ) + type;
+    const std::string d = std::string( "-d" ) + type;
+
+    const perf_case cases[] =
+    {
+        { "fixed",           e + k,         d + k,        true  },
+        { "adaptive",        e + k + a,     d + k + a,    true  },
+        { "blocks",          e + k + jobs,  d + k + jobs, true  },
+        { "parallel stream", e + k,         d + k + p,    false },
+        { "frame auto",      e + " -kauto", d + " -f",    true  },
+    };
+
+    n_values = corpus_bytes / sizeof( ValueT );
+
+    for( const auto dist : { distribution::geometric, distribution::laplacian, distribution::uniform, distribution::sparse } )
+    {
+        const auto prefix = std::string( type ) + " " + name( dist ) + " ";
+
+        bool generated = false;
+        for( const auto & c : cases )
+        {
+            if( !selected( c.operation, type ) )
+            {
+                continue;
+            }
+
+            if( !generated )
+            {
+                const auto values = generate< ValueT >( dist );
+                if( !write_file( "perf.bin", values.data(), values.size() * sizeof( ValueT ) ) )
+                {
+                    std::perror( "perf.bin" );
+                    ++failures;
+                    return;
+                }
+
+                generated = true;
+            }
+
+            // The results of a failed case are not recorded
+            const auto encode_seconds = run_golomb( c.encode_options, "perf.bin", "perf.egc", c.timed_encode ? perf_runs : 1 );
+            if( !encode_seconds )
+            {
+                continue;
+            }
+
+            const auto decode_seconds = run_golomb( c.decode_options, "perf.egc", "perf.out" );
+            if( !decode_seconds )
+            {
+                continue;
+            }
+
+            if( !same_files( "perf.bin", "perf.out" ) )
+            {
+                std::printf( ">>> %s%s decoded incorrect data!\n", prefix.c_str(), c.operation );
+                ++failures;
+                continue;
+            }
+
+            const auto bytes = static_cast< double >( corpus_bytes );
+
+            if( c.timed_encode )
+            {
+                results.emplace_back( prefix + c.operation + " encode", bytes / *encode_seconds / 1e6 );
+            }
+            results.emplace_back( prefix + c.operation + " decode", bytes / *decode_seconds / 1e6 );
+        }
+    }
+
+    std::remove( "perf.bin" );
+    std::remove( "perf.egc" );
+    std::remove( "perf.out" );
+}
+
+// Runs the performance tests of the golomb utility and compares the results with the baseline.
+// The baseline is written when it doesn't exist or when it is updated.
+static void perf_tests()
+{
+    std::printf( "%zu bytes per corpus, k=%zu, shift=%zu\n", corpus_bytes, bench_k, bench_shift );
+
+    perf_results baseline;
+    const bool   has_baseline = read_results( baseline_path, baseline );
+
+    perf_results results;
+    perf_type< uint8_t  >( "u8",  results );
+    perf_type< int8_t   >( "i8",  results );
+    perf_type< uint16_t >( "u16", results );
+    perf_type< int16_t  >( "i16", results );
+    perf_type< uint32_t >( "u32", results );
+    perf_type< int32_t  >( "i32", results );
+    perf_type< uint64_t >( "u64", results );
+    perf_type< int64_t  >( "i64", results );
+
+    for( const auto & [ test, throughput ] : results )
+    {
+        const auto base = std::find_if( baseline.begin(), baseline.end(), [ & ]( const auto & b ) { return b.first == test; } );
+        if( base == baseline.end() )
+        {
+            std::printf( "%-40s %10.2f MB/s\n", test.c_str(), throughput );
+            continue;
+        }
+
+        const auto change = 100.0 * ( throughput - base->second ) / base->second;
+
+        std::printf( "%-40s %10.2f MB/s %+8.1f %%\n", test.c_str(), throughput, change );
+        if( change < -threshold && !update_baseline )
+        {
+            std::printf( ">>> %s is %.1f %% slower than the baseline of %.2f MB/s!\n", test.c_str(), -change, base->second );
+            ++failures;
+        }
+    }
+
+    if( failures )
+    {
+        std::printf( "Baseline not written because of %d failures\n", failures );
+    }
+    else if( !has_baseline || update_baseline )
+    {
+        write_results( baseline_path, results );
+        std::printf( "Baseline written to '%s'\n", baseline_path );
+    }
+}
+
+static void help()
+{
+    std::printf(
+        "Usage: bench [-nN] [FILTER]\n"
+        "       bench -cBASELINE [-sN] [-tN] [-u] [FILTER]\n"
+        "\n"
+        "Runs the golomb encoder and decoder benchmarks with 'N' values per data set,\n"
+        "default is 1048576. When 'FILTER' is given only the benchmarks of which the\n"
+        "name contains 'FILTER' or the benchmarks for data type 'FILTER' run.\n"
+        "\n"
+        "Each benchmark reports the fastest of %d runs; values/s, the bytes/s of\n"
+        "unencoded data and the average number of encoded bits per value.\n"
+        "\n"
+        "With option 'c' the golomb utility in the current directory encodes and\n"
+        "decodes generated corpora of 'N' bytes, option 's', default is 268435456.\n"
+        "The throughputs are compared with the BASELINE file, which is written when\n"
+        "it doesn't exist or with option 'u'. A test fails when it is more than 'N'\n"
+        "percent slower than the baseline, option 't', default is 10.\n", bench_runs );
+}
+
+int main( int argc, char * argv[] )
+{
+    for( int i = 1 ; i < argc ; ++i )
+    {
+        if( std::strncmp( argv[ i ], "-n", 2 ) == 0 )
+        {
+            n_values = std::strtoull( argv[ i ] + 2, nullptr, 10 );
+            if( n_values == 0u )
+            {
+                help();
+                return 1;
+            }
+        }
+        else if( std::strncmp( argv[ i ], "-c", 2 ) == 0 && argv[ i ][ 2 ] != '\0' )
+        {
+            baseline_path = argv[ i ] + 2;
+        }
+        else if( std::strncmp( argv[ i ], "-s", 2 ) == 0 )
+        {
+            corpus_bytes = std::strtoull( argv[ i ] + 2, nullptr, 10 );
+            if( corpus_bytes < 8u )
+            {
+                help();
+                return 1;
+            }
+        }
+        else if( std::strncmp( argv[ i ], "-t", 2 ) == 0 )
+        {
+            threshold = std::strtod( argv[ i ] + 2, nullptr );
+        }
+        else if( std::strcmp( argv[ i ], "-u" ) == 0 )
+        {
+            update_baseline = true;
+        }
+        else if( argv[ i ][ 0 ] == '-' )
+        {
+            help();
+            return argv[ i ][ 1 ] == 'h' ? 0 : 1;
+        }
+        else
+        {
+            filter = argv[ i ];
+        }
+    }
+
+    if( baseline_path )
+    {
+        perf_tests();
+
+        return failures ? 1 : 0;
+    }
+
+    std::printf( "%zu values per data set, k=%zu, shift=%zu\n", n_values, bench_k, bench_shift );
+
+    bench_type< uint8_t  >( "u8"  );
+    bench_type< int8_t   >( "i8"  );
+    bench_type< uint16_t >( "u16" );
+    bench_type< int16_t  >( "i16" );
+    bench_type< uint32_t >( "u32" );
+    bench_type< int32_t  >( "i32" );
+    bench_type< uint64_t >( "u64" );
+    bench_type< int64_t  >( "i64" );
+
+    return failures ? 1 : 0;
+}
@@ -28,10 +28,15 @@
 #include <limits>
 #include <iterator>
 #include <bit>
+#include <span>
+#include <memory>
+#include <cstring>
 #include <type_traits>
-#if !defined( __cpp_lib_byteswap )
+#include <utility>
 #include <algorithm>
-#endif
+#include <array>
+#include <tuple>
+#include <vector>
 
 
 namespace pg::golomb
@@ -56,9 +61,19 @@ template< typename InputRange >
 concept unsigned_integral_input_range = std::unsigned_integral< std::ranges::range_value_t< InputRange > > &&
                                         std::ranges::input_range< InputRange >;
 
-template< typename InputValueT, typename OutputDataT >
-concept overruns_buffer = std::numeric_limits< typename std::make_unsigned< InputValueT >::type >::digits >=
-                          std::numeric_limits< OutputDataT >::digits;
+// An output iterator that can take a full 64 bit encoder buffer at once, see chunked_buffer
+template< typename OutputIt, typename DataT >
+concept contiguous_word_iterator = std::contiguous_iterator< OutputIt > && std::same_as< std::iter_value_t< OutputIt >, DataT >;
+
+template< typename OutputIt, typename DataT >
+concept buffer_store_iterator = std::same_as< typename OutputIt::word_type, DataT > &&
+                                requires( OutputIt & output, uint64_t data )
+{
+    { output.try_store( data ) } -> std::same_as< bool >;
+};
+
+template< std::unsigned_integral DataT >
+using bit_buffer_t = typename std::conditional< ( std::numeric_limits< DataT >::digits > 64 ), DataT, uint64_t >::type;
 
 template< std::integral ValueT >
 [[nodiscard]] constexpr ValueT make_mask( size_t n_bits )
@@ -74,43 +89,148 @@ template< std::integral ValueT >
 }
 
 template< std::unsigned_integral DataT >
+[[nodiscard]] constexpr DataT byteswap( DataT data )
+{
+#if defined( __cpp_lib_byteswap )
+    return std::byteswap( data );
+#else
+    // Moves each byte to its mirrored position; compilers recognize this as a single byte swap instruction
+    return [ data ]< size_t... Bytes >( std::index_sequence< Bytes... > )
+    {
+        return static_cast< DataT >( ( ( static_cast< DataT >( ( data >> ( 8u * Bytes ) ) & 0xFFu ) << ( 8u * ( sizeof( DataT ) - 1u - Bytes ) ) ) | ... ) );
+    }( std::make_index_sequence< sizeof( DataT ) >{} );
+#endif
+}
+
+// Converts a word between native byte order and 'WordOrder'; the bitstream is stored in big endian by default.
+template< std::endian WordOrder = std::endian::big, std::unsigned_integral DataT >
 [[nodiscard]] constexpr auto fix_endian( DataT data )
 {
     static_assert( std::endian::native == std::endian::big ||
                    std::endian::native == std::endian::little );
 
-    if constexpr( std::endian::native == std::endian::big ||
+    if constexpr( std::endian::native == WordOrder ||
                   sizeof( DataT ) == 1 )
     {
         return data;
     }
     else
     {
-#if defined( __cpp_lib_byteswap )
-        return std::byteswap( data );
-#else
-        using RawDataT = std::array< uint8_t, sizeof( DataT ) >;
+        return byteswap( data );
+    }
+}
 
-        auto raw_data = reinterpret_cast< RawDataT* >( &data );
+// Loads 64 bits stored in big endian byte order from unaligned memory.
+[[nodiscard]] inline uint64_t load_big_endian( const void * data )
+{
+    uint64_t loaded;
+    std::memcpy( &loaded, data, sizeof( loaded ) );
 
-        std::ranges::reverse( *raw_data );
+    return fix_endian( loaded );
+}
 
-        return data;
-#endif
+// Stores 64 bits in big endian byte order to unaligned memory.
+inline void store_big_endian( void * data, uint64_t stored )
+{
+    stored = fix_endian( stored );
+    std::memcpy( data, &stored, sizeof( stored ) );
+}
+
+// Returns the number of bits of the codeword of an unsigned value 'u' with 'value_digits' binary digits.
+// 'k' must be smaller than 'value_digits'.
+template< std::unsigned_integral UnsignedT >
+[[nodiscard]] constexpr size_t codeword_length( UnsignedT u, size_t k )
+{
+    constexpr auto value_digits = static_cast< size_t >( std::numeric_limits< UnsignedT >::digits );
+
+    const auto data = static_cast< UnsignedT >( u + static_cast< UnsignedT >( static_cast< UnsignedT >( 1u ) << k ) );
+    if( data < u ) [[unlikely]]
+    {
+        // The carry of the base is written as a separate bit
+        return 2u * value_digits + 1u - k;
     }
+
+    return 2u * static_cast< size_t >( std::bit_width( data ) ) - k - 1u;
 }
 
-template< typename OutputIt, std::unsigned_integral OutputDataT >
+// Lookup tables for the small values at the small orders that are known at compile time.
+inline constexpr int small_table_max_order = 2;
+inline constexpr int small_table_values    = 16;
+inline constexpr int small_table_bits      = 8;
+
+struct small_codeword
+{
+    uint8_t codeword;
+    uint8_t length;
+};
+
+// Maps 'small_table_bits' of encoded data to the values of the complete codewords at their start.
+struct small_codewords
+{
+    std::array< uint8_t, small_table_bits > values;
+    uint8_t                                 count;
+    uint8_t                                 length;
+};
+
+// Selects the lookup tables for orders that are passed as an std::integral_constant.
+template< typename OrderT >
+inline constexpr bool has_small_tables = false;
+
+template< int K >
+inline constexpr bool has_small_tables< std::integral_constant< int, K > > = K <= small_table_max_order;
+
+template< int K >
+inline constexpr auto small_encode_table = []()
+{
+    std::array< small_codeword, small_table_values > table = {};
+    for( int u = 0 ; u < small_table_values ; ++u )
+    {
+        table[ u ].codeword = static_cast< uint8_t >( u + ( 1 << K ) );
+        table[ u ].length   = static_cast< uint8_t >( codeword_length( static_cast< unsigned >( u ), K ) );
+    }
+
+    return table;
+}();
+
+template< int K >
+inline constexpr auto small_decode_table = []()
+{
+    std::array< small_codewords, 1u << small_table_bits > table = {};
+    for( unsigned bits = 0u ; bits < table.size() ; ++bits )
+    {
+        auto& entry = table[ bits ];
+        while( true )
+        {
+            // The bits of the codewords that are not decoded yet, aligned to the most significant bit
+            const auto remaining = static_cast< uint8_t >( bits << entry.length );
+            const auto zeros     = std::countl_zero( remaining );
+            const auto length    = 2 * zeros + K + 1;
+            if( entry.length + length > small_table_bits )
+            {
+                break;
+            }
+
+            const auto codeword = remaining >> ( small_table_bits - length );
+
+            entry.values[ entry.count++ ] = static_cast< uint8_t >( codeword - ( 1 << K ) );
+            entry.length                  = static_cast< uint8_t >( entry.length + length );
+        }
+    }
+
+    return table;
+}();
+
+template< std::endian WordOrder, typename OutputIt, std::unsigned_integral OutputDataT >
 requires std::output_iterator< OutputIt, OutputDataT >
 constexpr void write( OutputIt& output, OutputDataT data )
 {
-    *output++ = fix_endian( data );
+    *output++ = fix_endian< WordOrder >( data );
 }
 
-template< detail::unsigned_integral_input_iterator InputIt >
+template< std::endian WordOrder, detail::unsigned_integral_input_iterator InputIt >
 [[nodiscard]] constexpr auto read( InputIt& input )
 {
-    return fix_endian( *input++ );
+    return fix_endian< WordOrder >( *input++ );
 }
 
 }
@@ -159,40 +279,145 @@ template< std::unsigned_integral UnsignedT >
  * \brief Golomb encoder object that encodes integral values and write them to an output
  *
  * The encoded values have a variable number of bits that are buffered and packed.
- * The buffer size is equal to the \em OutputDataT and written to the output when all bits are set by the encoder.
+ * The bits are collected in a buffer of at least 64 bits which is written to the output as a sequence of
+ * \em OutputDataT when all its bits are set by the encoder.
  * 
  * \tparam OutputIt     The type of the output iterator to which the encoded values are written
  * \tparam OutputDataT  An unsigned integral type which is used for the data that is written to output
+ * \tparam WordOrder    The byte order of the \em OutputDataT words; big endian makes the bitstream independent of
+ *                      \em OutputDataT, \em std::endian::native skips the byte swaps for systems where the encoder and
+ *                      decoder have the same endianess
  */
-template< typename OutputIt, std::unsigned_integral OutputDataT = uint8_t >
+template< typename OutputIt, std::unsigned_integral OutputDataT = uint8_t, std::endian WordOrder = std::endian::big >
 requires std::output_iterator< OutputIt, OutputDataT >
 class encoder
 {
+    using BufferT = detail::bit_buffer_t< OutputDataT >;
+
     static constexpr auto output_digits = std::numeric_limits< OutputDataT >::digits;
+    static constexpr auto buffer_digits = std::numeric_limits< BufferT >::digits;
+
+    OutputIt output;
+    BufferT  buffer;
+    int      buffer_bits_free;
+    size_t   words_written;
+
+    // Writes the buffer to output, the most significant word first.
+    constexpr void write_buffer( int n_words )
+    {
+        words_written += n_words;
+
+        // A full buffer is stored with a single byte swap to contiguous output of words, like the decoder's refill
+        if constexpr( detail::contiguous_word_iterator< OutputIt, OutputDataT > && buffer_digits == 64 && WordOrder == std::endian::big )
+        {
+            if( !std::is_constant_evaluated() && n_words == buffer_digits / output_digits )
+            {
+                detail::store_big_endian( std::to_address( output ), buffer );
+                output += n_words;
+
+                return;
+            }
+        }
+        else if constexpr( detail::buffer_store_iterator< OutputIt, OutputDataT > && buffer_digits == 64 && WordOrder == std::endian::big )
+        {
+            // Paged output takes a full buffer in one store when the current page has room for it
+            if( !std::is_constant_evaluated() && n_words == buffer_digits / output_digits && output.try_store( buffer ) )
+            {
+                return;
+            }
+        }
+
+        for( int shift = buffer_digits - output_digits ; n_words > 0 ; shift -= output_digits, --n_words )
+        {
+            detail::write< WordOrder >( output, static_cast< OutputDataT >( buffer >> shift ) );
+        }
+    }
 
-    OutputIt    output;
-    OutputDataT buffer;
-    int         buffer_bits_free;
+    // Appends the lower 'n_bits' of 'data' to the buffer.
+    // 'n_bits' must be in the range [1, buffer_digits] and 'data' must not have bits set above 'n_bits'.
+    constexpr void put( BufferT data, int n_bits )
+    {
+        if( n_bits < buffer_bits_free )
+        {
+            buffer_bits_free -= n_bits;
+            buffer           |= data << buffer_bits_free;
+        }
+        else
+        {
+            n_bits -= buffer_bits_free;
+            buffer |= data >> n_bits;
+
+            write_buffer( buffer_digits / output_digits );
+
+            buffer_bits_free = buffer_digits - n_bits;
+            buffer           = n_bits ? data << buffer_bits_free : BufferT{};
+        }
+    }
 
-    template< std::integral InputValueT, size_t K >
-    constexpr OutputIt push_switch( InputValueT x, size_t k )
+    // Encodes 'value' with order 'k', 'k' must be smaller than the number of binary digits of 'InputValueT'.
+    // 'k' is an int for an order that is known at runtime, or an std::integral_constant for an order that is
+    // known at compile time. Both share this kernel, a runtime order does not need a dispatch to a template instance.
+    template< std::integral InputValueT, typename OrderT >
+    constexpr void put_value( InputValueT value, OrderT k )
     {
-        using UnsignedInputValueT = std::make_unsigned< InputValueT >::type;
+        using UnsignedInputValueT = typename std::make_unsigned< InputValueT >::type;
+
+        constexpr auto value_digits = std::numeric_limits< UnsignedInputValueT >::digits;
 
-        constexpr auto max_K = std::numeric_limits< UnsignedInputValueT >::digits - 1;
-        if constexpr( K < max_K )
+        const auto base           = static_cast< UnsignedInputValueT >( static_cast< UnsignedInputValueT >( 1u ) << k );
+        const auto unsigned_value = to_unsigned( value );
+
+        if constexpr( detail::has_small_tables< OrderT > )
         {
-            if( k == K )
+            if( unsigned_value < detail::small_table_values )
             {
-                return push< K, InputValueT >( x );
+                const auto [ codeword, length ] = detail::small_encode_table< OrderT::value >[ unsigned_value ];
+
+                put( codeword, length );
+                return;
             }
+        }
+        const auto data           = static_cast< UnsignedInputValueT >( unsigned_value + base );
 
-            return push_switch< InputValueT, K + 1u >( x, k );
+        if( data < unsigned_value ) [[unlikely]]
+        {
+            // Adding the base overflowed, the carry is written as a separate bit
+            put( BufferT{}, value_digits - k );
+            put( 1u, 1 );
+            put( data, value_digits );
         }
         else
         {
-            return push< max_K >( x );
+            // The leading zeros are written together with the data as one codeword when it fits in the buffer
+            const auto data_bits = std::bit_width( data );
+            const auto length    = 2 * data_bits - ( k + 1 );
+
+            if( 2 * value_digits - 1 <= buffer_digits || length <= buffer_digits )
+            {
+                put( data, length );
+            }
+            else
+            {
+                put( BufferT{}, length - data_bits );
+                put( data, data_bits );
+            }
+        }
+    }
+
+    // Encodes 'values' with a local copy of the encoder of which the address isn't taken.
+    template< std::integral InputValueT, typename OrderT >
+    constexpr OutputIt put_values( std::span< const InputValueT > values, OrderT k )
+    {
+        auto local = *this;
+
+        for( const auto value : values )
+        {
+            local.put_value( value, k );
         }
+
+        *this = local;
+
+        return output;
     }
 
 public:
@@ -205,8 +430,9 @@ public:
      */
     constexpr encoder( OutputIt output )
         : output( output )
-        , buffer( static_cast< OutputDataT>( 0u ) )
-        , buffer_bits_free( output_digits )
+        , buffer( BufferT{} )
+        , buffer_bits_free( buffer_digits )
+        , words_written( 0u )
     {}
 
     /**
@@ -217,141 +443,127 @@ public:
      *
      * \param x  The value to encode
      *
+     * \note \em k must be smaller than the \em InputValueT's maximum number of binary digits.
+     *
      * \return The output iterator one past the data that has been written to the output
      */
     template< size_t k, typename InputValueT >
-    requires std::integral< InputValueT > && detail::overruns_buffer< InputValueT, OutputDataT >
+    requires std::integral< InputValueT >
     constexpr OutputIt push( InputValueT value )
     {
         using UnsignedInputValueT = typename std::make_unsigned< InputValueT >::type;
 
-        constexpr auto base         = static_cast< UnsignedInputValueT >( 1u ) << k;
-        constexpr auto value_digits = std::numeric_limits< UnsignedInputValueT >::digits;
-
-        const auto unsigned_value = to_unsigned( value );
-        auto       data           = static_cast< UnsignedInputValueT >( unsigned_value + base );
-
-        const auto overflowed         = data < unsigned_value;
-        auto       data_bits_to_write = overflowed ? value_digits : std::bit_width( data );
-        auto       zeros              = data_bits_to_write - static_cast< int >( overflowed ? k : k + 1 );
-
-        while( zeros >= buffer_bits_free )
-        {
-            detail::write( output, buffer );
-            buffer            = {};
-            zeros            -= buffer_bits_free;
-            buffer_bits_free  = output_digits;
-        }
-        buffer_bits_free -= zeros;
-
-        if( overflowed )
-        {
-            --buffer_bits_free;
-            buffer |= static_cast< OutputDataT >( 1u ) << buffer_bits_free;
-        }
-
-        while( data_bits_to_write > 0 )
-        {
-            if( buffer_bits_free == 0 )
-            {
-                detail::write( output, buffer );
-                buffer           = {};
-                buffer_bits_free = output_digits;
-            }
-            else
-            {
-                if( data_bits_to_write < buffer_bits_free )
-                {
-                    const auto shift = buffer_bits_free - data_bits_to_write;
+        static_assert( k < std::numeric_limits< UnsignedInputValueT >::digits );
 
-                    buffer             |= data << shift;
-                    buffer_bits_free   -= data_bits_to_write;
-                    data_bits_to_write  = {};
-                }
-                else
-                {
-                    const auto shift = data_bits_to_write - buffer_bits_free;
-                    const auto mask  = detail::make_mask< UnsignedInputValueT >( buffer_bits_free ) << shift;
-                    const auto chunk = data & mask;
-
-                    buffer             |= chunk >> shift;
-                    data_bits_to_write -= buffer_bits_free;
-                    buffer_bits_free    = {};
-                    data               &= ~mask;
-                }
-            }
-        }
+        put_value( value, std::integral_constant< int, static_cast< int >( k ) >{} );
 
         return output;
     }
 
     /**
-     * \overload OutputIt push( InputValueT value )
+     * \overload push( InputValueT x )
+     *
+     * \tparam InputValueT  Integral type of value \em x
+     *
+     * \param x  The value to encode
+     * \param k  The order with which \em x is encoded
+     *
+     * \note \em k is limited to the \em InputValueT's maximum number of binary digits minus one.
      */
-    template< size_t k, typename InputValueT >
-    requires std::integral< InputValueT > && ( !detail::overruns_buffer< InputValueT, OutputDataT > )
-    constexpr OutputIt push( InputValueT value )
+    template< std::integral InputValueT >
+    constexpr OutputIt push( InputValueT x, size_t k )
     {
-        constexpr auto base = static_cast< OutputDataT >( 1u ) << k;
-
-        const auto unsigned_value     = to_unsigned( value );
-        auto       data               = static_cast< OutputDataT >( unsigned_value + base );
-        auto       data_bits_to_write = std::bit_width( data );
-        auto       zeros              = data_bits_to_write - static_cast< int >( k + 1 );
+        using UnsignedInputValueT = typename std::make_unsigned< InputValueT >::type;
 
-        if( zeros >= buffer_bits_free )
-        {
-            detail::write( output, buffer );
-            buffer            = {};
-            zeros            -= buffer_bits_free;
-            buffer_bits_free  = output_digits;
-        }
-        buffer_bits_free -= zeros;
+        constexpr auto max_k = static_cast< size_t >( std::numeric_limits< UnsignedInputValueT >::digits - 1 );
 
-        if( data_bits_to_write >= buffer_bits_free )
-        {
-            const auto shift  = data_bits_to_write - buffer_bits_free;
-            const auto shift2 = output_digits - shift;
+        put_value( x, static_cast< int >( std::min( k, max_k ) ) );
 
-            buffer |= data >> shift;
-            detail::write( output, buffer );
+        return output;
+    }
 
-            buffer           = data << shift2;
-            buffer_bits_free = shift2;
-        }
-        else
-        {
-            const auto shift = buffer_bits_free - data_bits_to_write;
+    /**
+     * \brief Encodes a block of values and writes the resulting bitstream to output
+     *
+     * The state of the encoder is kept in locals while the block is encoded, so that the compiler can keep the
+     * bit buffer in registers instead of storing it through the encoder for each value.
+     *
+     * \tparam k            Golomb order in which the \em values will be encoded
+     * \tparam InputValueT  Integral type of the values
+     *
+     * \param values  The values to encode
+     *
+     * \note \em k must be smaller than the \em InputValueT's maximum number of binary digits.
+     *
+     * \return The output iterator one past the data that has been written to the output
+     */
+    template< size_t k, std::integral InputValueT >
+    constexpr OutputIt push_n( std::span< const InputValueT > values )
+    {
+        using UnsignedInputValueT = typename std::make_unsigned< InputValueT >::type;
 
-            buffer             |= data << shift;
-            buffer_bits_free   -= data_bits_to_write;
-        }
+        static_assert( k < std::numeric_limits< UnsignedInputValueT >::digits );
 
-        return output;
+        return put_values( values, std::integral_constant< int, static_cast< int >( k ) >{} );
     }
 
+    /**
+     * \overload push_n( std::span< const InputValueT > values )
+     *
+     * \tparam InputValueT  Integral type of the values
+     *
+     * \param values  The values to encode
+     * \param k       The order with which the values are encoded
+     *
+     * \note \em k is limited to the \em InputValueT's maximum number of binary digits minus one.
+     */
     template< std::integral InputValueT >
-    constexpr OutputIt push( InputValueT x, size_t k )
+    constexpr OutputIt push_n( std::span< const InputValueT > values, size_t k )
     {
-        return push_switch< InputValueT, 0u >( x, k );
+        using UnsignedInputValueT = typename std::make_unsigned< InputValueT >::type;
+
+        constexpr auto max_k = static_cast< size_t >( std::numeric_limits< UnsignedInputValueT >::digits - 1 );
+
+        return put_values( values, static_cast< int >( std::min( k, max_k ) ) );
     }
 
     /**
      * \brief Flushes the internal bitbuffer to output
      *
+     * The last word written to the output is padded with zeros.
+     *
      * \return The output iterator one past the data that has been flushed to the output
      */
     constexpr OutputIt flush()
     {
-        if( buffer_bits_free < output_digits )
+        const auto buffered_bits = buffer_digits - buffer_bits_free;
+        if( buffered_bits )
         {
-            detail::write( output, buffer );
+            write_buffer( ( buffered_bits + output_digits - 1 ) / output_digits );
             buffer           = {};
-            buffer_bits_free = output_digits;
+            buffer_bits_free = buffer_digits;
         }
 
         return output;
     }
+
+    /**
+     * \brief Returns the number of \em OutputDataT words that are written to the output
+     *
+     * \note Bits that are buffered by the encoder are written to the output by \em flush.
+     */
+    [[nodiscard]] constexpr size_t size() const
+    {
+        return words_written;
+    }
+
+    /**
+     * \brief Returns the number of bits of the encoded values, including the bits that are buffered by the encoder
+     */
+    [[nodiscard]] constexpr size_t bit_size() const
+    {
+        return words_written * output_digits + static_cast< size_t >( buffer_digits - buffer_bits_free );
+    }
 };
 
 /**
@@ -399,153 +611,546 @@ constexpr auto encode( InputRangeT input, OutputIt output, size_t k = {} )
 
     encoder< OutputIt, OutputDataT > e( output );
 
-    for( const auto& value : input )
+    if constexpr( std::ranges::contiguous_range< InputRangeT > && std::ranges::sized_range< InputRangeT > )
+    {
+        e.push_n( std::span< const InputValueT >( std::ranges::data( input ), std::ranges::size( input ) ), k );
+    }
+    else
     {
-        e.push( static_cast< InputValueT >( value ), k );
+        for( const auto& value : input )
+        {
+            e.push( static_cast< InputValueT >( value ), k );
+        }
     }
 
     return e.flush();
 }
 
 /**
- * \brief Golomb decoder status when finished decoding a value from the input.
+ * \brief Returns the maximum number of \em OutputDataT words that \em n encoded values of \em InputValueT take
+ *
+ * \tparam InputValueT  The integral type of the values that are encoded
+ * \tparam OutputDataT  An unsigned integral type which is used for the encoded data
+ *
+ * \param n  The number of values that are encoded
+ * \param k  The order with which the values are encoded
  */
-enum decoder_status
+template< std::integral InputValueT, std::unsigned_integral OutputDataT = uint8_t >
+[[nodiscard]] constexpr size_t max_encoded_size( size_t n, size_t k = {} )
 {
-    success,        ///< Decoded successfuly; value is valid
-    done,           ///< No more data available to decode
-    zero_overflow,  ///< Exceeded leading zeros for \em OutputVaueT and given order;
-                    // value holds the number of zeros (clipped at max for OutputValueT).
+    using UnsignedInputValueT = typename std::make_unsigned< InputValueT >::type;
+
+    constexpr auto value_digits  = static_cast< size_t >( std::numeric_limits< UnsignedInputValueT >::digits );
+    constexpr auto output_digits = static_cast< size_t >( std::numeric_limits< OutputDataT >::digits );
+
+    const auto max_length = 2u * value_digits + 1u - std::min( k, value_digits - 1u );
+
+    return ( n * max_length + output_digits - 1u ) / output_digits;
+}
+
+/**
+ * \brief Golomb encoder status when finished encoding values to a span.
+ */
+enum encoder_status
+{
+    encoded,      ///< All the values are encoded
+    output_full,  ///< The output has no room for the next value
 };
 
 /**
- * \brief Golomb decoder_result object that holds the decoded value and/or the decoder status
+ * \brief Golomb encoder_batch_result object that holds the number of encoded values, the size of the output and the status
  */
-template< std::integral OutputValueT >
-struct decoder_result
+struct encoder_batch_result
 {
-    OutputValueT   value;
-    decoder_status status;
+    size_t         count;  ///< The number of values that are encoded; the index of the first value that is not encoded
+    size_t         size;   ///< The number of words written to the output
+    encoder_status status;
 };
 
 /**
- * \brief Golomb decoder object that decodes golomb data and write its values to an output
+ * \brief Encodes integral values from an input into a span with a specified golomb order
  *
- * All data fed to the decoder is scanned immediately. The values found while scanning are written to the output.
- * Remainig bits are buffered and processed when more data is fed to the decoder.
+ * The values are encoded without bounds checks as long as the output has room for the longest possible codewords.
+ * Only the values near the end of the output have their exact codeword length checked.
+ * The output is flushed when the next value does not fit, the written data holds a complete bitstream of
+ * the values that are encoded before it.
  *
- * \tparam OutputIt    The type of the output iterator to which the decoded values are written
- * \tparam OutputDataT The integral type of the decoded values
+ * \tparam OutputDataT  An unsigned integral type which is used for the data that is written to output
  *
- * \note Be sure the values encoded in the golomb data fits within value range of \em OutputDataT.
+ * \param input   An input iterator to read integral values from
+ * \param last    The iterator that marks the end of input range
+ * \param output  The span to which the encoded data is written, see also \em max_encoded_size
+ * \param k       The order the values from input will be encoded
+ *
+ * \return A \em encoder_batch_result struct. The status is \em encoded when all the values are encoded or
+ *         \em output_full when the value at index \em count did not fit in the output.
  */
-template< detail::unsigned_integral_input_iterator InputIt >
-class decoder
+template< std::unsigned_integral OutputDataT,
+          detail::integral_input_iterator InputIt >
+constexpr encoder_batch_result encode_into( InputIt input, InputIt last, std::span< OutputDataT > output, size_t k = {} )
 {
-    using InputDataT = typename std::iterator_traits< InputIt >::value_type;
+    using ValueT              = typename std::iterator_traits< InputIt >::value_type;
+    using UnsignedInputValueT = typename std::make_unsigned< ValueT >::type;
 
-    static constexpr auto data_digits = std::numeric_limits< InputDataT >::digits;
-    static constexpr auto data_mask   = std::numeric_limits< InputDataT >::max();
+    constexpr auto value_digits  = static_cast< size_t >( std::numeric_limits< UnsignedInputValueT >::digits );
+    constexpr auto output_digits = static_cast< size_t >( std::numeric_limits< OutputDataT >::digits );
 
-    InputIt    input;
-    InputIt    input_end;
-    size_t     data_bits_remaining;
-    InputDataT data;
+    k = std::min( k, value_digits - 1u );
 
-    template< std::integral OutputValueT, size_t K = {} >
-    [[nodiscard]] decoder_result< OutputValueT > constexpr pull_switch( size_t k )
-    {
-        using UnsignedOutputValueT = typename std::make_unsigned< OutputValueT >::type;
+    const auto max_length    = 2u * value_digits + 1u - k;
+    const auto capacity_bits = output.size() * output_digits;
 
-        constexpr auto max_K = std::numeric_limits< UnsignedOutputValueT >::digits - 1;
-        if constexpr ( K < max_K )
+    encoder< OutputDataT *, OutputDataT > e( output.data() );
+
+    size_t count = {};
+    while( input != last )
+    {
+        // Values that fit for sure are encoded without checks
+        for( auto n_unchecked = ( capacity_bits - e.bit_size() ) / max_length ; n_unchecked > 0u && input != last ; --n_unchecked )
         {
-            if( k == K )
-            {
-                return pull< OutputValueT, K >();
-            }
+            e.push( static_cast< ValueT >( *input++ ), k );
+            ++count;
+        }
 
-            return pull_switch< OutputValueT, K + 1u >( k );
+        if( input == last )
+        {
+            break;
         }
-        else
+
+        const auto value = static_cast< ValueT >( *input );
+        if( detail::codeword_length( to_unsigned( value ), k ) > capacity_bits - e.bit_size() )
         {
-            return pull< OutputValueT, max_K >();
+            e.flush();
+            return { count, e.size(), encoder_status::output_full };
         }
+
+        e.push( value, k );
+        ++input;
+        ++count;
     }
 
-    [[nodiscard]] constexpr bool check_data()
+    e.flush();
+    return { count, e.size(), encoder_status::encoded };
+}
+
+/**
+ * \overload encode_into( InputIt input, InputIt last, std::span< OutputDataT > output, size_t k = {} )
+ *
+ * \tparam OutputDataT  An unsigned integral type which is used for the data that is written to output
+ *
+ * \param input   A range to read integral values from that are encoded
+ * \param output  The span to which the encoded data is written, see also \em max_encoded_size
+ * \param k       The order the values from input will be encoded
+ */
+template< std::unsigned_integral OutputDataT,
+          detail::integral_input_range InputRangeT >
+constexpr encoder_batch_result encode_into( InputRangeT input, std::span< OutputDataT > output, size_t k = {} )
+{
+    return encode_into< OutputDataT >( std::begin( input ), std::end( input ), output, k );
+}
+
+/**
+ * \brief A growable buffer for encoded data that is stored in pages of a fixed size
+ *
+ * The buffer is the output for encoding a sequence of messages without memory allocations: \em clear keeps
+ * the pages, so once the buffer has grown to the size of the largest message the next ones reuse them.
+ * The data is not contiguous; \em chunks returns a span per page which can be used as a gather list,
+ * e.g. for an iovec array of writev, or fed one by one to a \em stream_decoder.
+ *
+ * \code
+ * pg::golomb::chunked_buffer<> buffer;
+ * buffer.commit( pg::golomb::encode( values, buffer.appender(), k ) );
+ * for( auto chunk : buffer.chunks() ) { ... }
+ * buffer.clear();
+ * \endcode
+ *
+ * \tparam DataT     An unsigned integral type which is used for the encoded data
+ * \tparam PageSize  The number of \em DataT words in a page
+ */
+template< std::unsigned_integral DataT = uint8_t, size_t PageSize = 65536u / sizeof( DataT ) >
+requires ( PageSize > 0u )
+class chunked_buffer
+{
+    std::vector< std::unique_ptr< DataT[] > > pages;
+    size_t                                    pages_used = {};  // The pages that hold data, the last one partially
+    size_t                                    last_size  = {};  // The number of words in the last page that is used
+
+    // Hands out the page after the last one that is used, the pages kept by clear are reused before a new one is allocated
+    [[nodiscard]] DataT * next_page()
     {
-        if( data_bits_remaining )
+        if( pages_used == pages.size() )
         {
-            return true;
+            pages.push_back( std::make_unique_for_overwrite< DataT[] >( PageSize ) );
         }
-        else if( input != input_end )
-        {
-            data                = detail::read( input );
-            data_bits_remaining = data_digits;
 
-            return true;
-        }
+        last_size = {};
 
-        return false;
+        return pages[ pages_used++ ].get();
     }
 
 public:
     /**
-     * \brief Construct the decoder
+     * \brief An output iterator that appends words to the buffer
      *
-     * \param input      Begin iterator of the decoder's input containing encoded golomb data.
-     * \param input_end  End iterator that marks the end of the input data.
+     * The iterator writes to the current page without bounds checks other than a compare with the page end.
+     * The words it writes are part of the buffer after it is passed to \em commit.
+     * Only one appender at a time must be used.
      */
-    [[nodiscard]] constexpr decoder( InputIt input_, InputIt input_end_ )
-        : input( input_ )
-        , input_end( input_end_ )
-        , data_bits_remaining( input == input_end ? 0u : data_digits )
-        , data( input == input_end ? 0u : detail::read( input ) )
-    {}
+    class append_iterator
+    {
+        friend chunked_buffer;
+
+        chunked_buffer * owner = {};
+        DataT          * pos   = {};
+        DataT          * end   = {};
+
+        constexpr append_iterator( chunked_buffer * b, DataT * p, DataT * e ) noexcept
+            : owner( b ), pos( p ), end( e )
+        {}
+
+    public:
+        using difference_type = std::ptrdiff_t;
+        using word_type       = DataT;
+
+        constexpr append_iterator() noexcept = default;
+
+        /**
+         * \brief Appends a word, only words of \em DataT are accepted so that an encoder's words match the pages
+         */
+        template< std::same_as< DataT > WordT >
+        append_iterator& operator=( WordT data )
+        {
+            if( pos == end ) [[unlikely]]
+            {
+                pos = owner->next_page();
+                end = pos + PageSize;
+            }
+
+            *pos++ = data;
+
+            return *this;
+        }
+
+        /**
+         * \brief Stores 64 bits in big endian byte order when the current page has room for them
+         *
+         * This is the fast path of an encoder with this iterator as output, it stores a full buffer at once.
+         *
+         * \return True when the bits are stored, false when the words must be written one by one
+         */
+        [[nodiscard]] bool try_store( uint64_t data ) noexcept
+        {
+            constexpr auto n_words = sizeof( data ) / sizeof( DataT );
+
+            if( static_cast< size_t >( end - pos ) < n_words )
+            {
+                return false;
+            }
+
+            detail::store_big_endian( pos, data );
+            pos += n_words;
+
+            return true;
+        }
+
+        // The state is in the iterator, these return the iterator itself so that '*output++ = data' advances it
+        constexpr append_iterator& operator*() noexcept { return *this; }
+        constexpr append_iterator& operator++() noexcept { return *this; }
+        constexpr append_iterator& operator++( int ) noexcept { return *this; }
+    };
 
     /**
-     * \brief Reads data from its input and returns a decoded result
-     *
-     * \tparam OutputValueT  Type of the value that is pulled
-     * \tparam k             Order of the golomb data to decode for the value that is pulled
-     *
-     * \note \em k should be smaler than the \em OutputValueT's maximum number of binary digits.
+     * \brief Returns an output iterator that appends words to the end of the buffer
+     */
+    [[nodiscard]] append_iterator appender() noexcept
+    {
+        if( pages_used == 0u )
+        {
+            return { this, nullptr, nullptr };
+        }
+
+        const auto page = pages[ pages_used - 1u ].get();
+
+        return { this, page + last_size, page + PageSize };
+    }
+
+    /**
+     * \brief Sets the end of the data to the position of an appender
      *
-     * \return A \em decoder_result struct containing the decoded value and/or decoder status
+     * \param output  The last state of an appender of this buffer, e.g. the iterator that \em encode returns
      */
-    template< std::integral OutputValueT, size_t k = {} >
-    [[nodiscard]] decoder_result< OutputValueT > constexpr pull()
+    void commit( const append_iterator & output ) noexcept
+    {
+        if( output.pos )
+        {
+            last_size = static_cast< size_t >( output.pos - pages[ pages_used - 1u ].get() );
+        }
+    }
+
+    /**
+     * \brief Makes the buffer empty, the pages are kept for reuse
+     */
+    void clear() noexcept
+    {
+        pages_used = {};
+        last_size  = {};
+    }
+
+    /**
+     * \brief Allocates pages up front such that \em n words can be appended without allocations
+     */
+    void reserve( size_t n )
+    {
+        const auto n_pages = ( n + PageSize - 1u ) / PageSize;
+
+        pages.reserve( n_pages );
+        while( pages.size() < n_pages )
+        {
+            pages.push_back( std::make_unique_for_overwrite< DataT[] >( PageSize ) );
+        }
+    }
+
+    /**
+     * \brief Returns the number of words in the buffer
+     */
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return pages_used ? ( pages_used - 1u ) * PageSize + last_size : size_t{};
+    }
+
+    /**
+     * \brief Returns true when the buffer holds no data
+     */
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size() == 0u;
+    }
+
+    /**
+     * \brief Returns the number of words that the allocated pages can hold
+     */
+    [[nodiscard]] size_t capacity() const noexcept
+    {
+        return pages.size() * PageSize;
+    }
+
+    /**
+     * \brief Returns the number of pages that hold data
+     */
+    [[nodiscard]] size_t chunk_count() const noexcept
+    {
+        return pages_used;
+    }
+
+    /**
+     * \brief Returns the data in page \em i, all pages except the last one are full
+     */
+    [[nodiscard]] std::span< const DataT > chunk( size_t i ) const noexcept
+    {
+        return { pages[ i ].get(), i + 1u < pages_used ? PageSize : last_size };
+    }
+
+    /**
+     * \brief Returns a view of the data as a span per page, in order
+     */
+    [[nodiscard]] auto chunks() const noexcept
+    {
+        return std::views::iota( size_t{}, pages_used ) |
+               std::views::transform( [ this ]( size_t i ) { return chunk( i ); } );
+    }
+};
+
+/**
+ * \brief Golomb decoder status when finished decoding a value from the input.
+ */
+enum decoder_status
+{
+    success,        ///< Decoded successfuly; value is valid
+    done,           ///< No more data available to decode
+    zero_overflow,  ///< Exceeded leading zeros for \em OutputVaueT and given order;
+                    // value holds the number of zeros (clipped at max for OutputValueT).
+    need_input,     ///< The input ended in the middle of a value; more input is required, see \em stream_decoder
+};
+
+/**
+ * \brief Golomb decoder_result object that holds the decoded value and/or the decoder status
+ */
+template< std::integral OutputValueT >
+struct decoder_result
+{
+    OutputValueT   value;
+    decoder_status status;
+};
+
+/**
+ * \brief Golomb decoder_batch_result object that holds the number of decoded values and the decoder status
+ */
+struct decoder_batch_result
+{
+    size_t         count;
+    decoder_status status;
+};
+
+template< std::unsigned_integral InputDataT >
+class stream_decoder;
+
+/**
+ * \brief Golomb decoder object that decodes golomb data and write its values to an output
+ *
+ * The data read from input is buffered in a window of at least 64 bits which is topped up with whole
+ * \em InputDataT words. Codewords that are completely buffered in the window are decoded at once,
+ * codewords that span more data than the window holds are decoded in parts.
+ *
+ * \tparam InputIt    The type of the input iterator from which the encoded golomb data is read
+ * \tparam WordOrder  The byte order of the input words, must be the same as the encoder's word order
+ *
+ * \note Be sure the values encoded in the golomb data fits within value range of \em OutputDataT.
+ */
+template< detail::unsigned_integral_input_iterator InputIt, std::endian WordOrder = std::endian::big >
+class decoder
+{
+    using InputDataT = typename std::iterator_traits< InputIt >::value_type;
+    using WindowT    = detail::bit_buffer_t< InputDataT >;
+
+    static constexpr auto data_digits   = std::numeric_limits< InputDataT >::digits;
+    static constexpr auto window_digits = std::numeric_limits< WindowT >::digits;
+
+    // Contiguous input in big endian word order, or of bytes, is loaded as a stream of bytes
+    static constexpr bool byte_stream = std::contiguous_iterator< InputIt > && window_digits == 64 &&
+                                        ( WordOrder == std::endian::big || data_digits == 8 );
+
+    InputIt input_begin;
+    InputIt input;
+    InputIt input_end;
+    WindowT window;         // Buffered bits aligned to the most significant bit
+    int     window_bits;    // Number of valid bits in the window, the bits that follow are zero or not yet consumed input
+    size_t  input_offset;   // Number of bytes of the word at 'input' that are loaded in the window, for a byte stream of wide words
+
+    // Returns the address of the next byte of a byte stream that is not loaded in the window.
+    [[nodiscard]] const unsigned char * input_bytes() const
+    {
+        return reinterpret_cast< const unsigned char * >( std::to_address( input ) ) + input_offset;
+    }
+
+    // Moves the input 'n_bytes' further, to the word that holds the next byte of a byte stream.
+    constexpr void skip_bytes( size_t n_bytes )
+    {
+        input_offset += n_bytes;
+        input        += static_cast< std::ptrdiff_t >( input_offset / sizeof( InputDataT ) );
+        input_offset %= sizeof( InputDataT );
+    }
+
+    // The stream decoder moves the input to the next chunk while keeping the window
+    template< std::unsigned_integral >
+    friend class stream_decoder;
+
+    // Tops up the window with input data.
+    constexpr void refill()
+    {
+        // Contiguous input is stored in the same order as the bitstream, independent of the size of InputDataT.
+        // This lets the window be topped up with a single load instead of word by word. The loaded bits past
+        // 'window_bits' are the bits of the input words that are not consumed yet.
+        if constexpr( byte_stream )
+        {
+            if( !std::is_constant_evaluated() )
+            {
+                if constexpr( data_digits < window_digits )
+                {
+                    constexpr auto load_size = static_cast< std::ptrdiff_t >( sizeof( uint64_t ) / sizeof( InputDataT ) );
+
+                    if( input_end - input >= load_size )
+                    {
+                        const auto n_words = ( window_digits - 1 - window_bits ) / data_digits;
+
+                        window      |= detail::load_big_endian( std::to_address( input ) ) >> window_bits;
+                        window_bits += n_words * data_digits;
+                        input       += n_words;
+
+                        return;
+                    }
+                }
+                else
+                {
+                    // A word as wide as the window is loaded in whole bytes, the word may be loaded partly
+                    const auto n_bytes_left = static_cast< size_t >( input_end - input ) * sizeof( InputDataT ) - input_offset;
+                    if( n_bytes_left >= sizeof( uint64_t ) )
+                    {
+                        const auto n_bytes = static_cast< size_t >( window_digits - 1 - window_bits ) / 8u;
+
+                        window      |= detail::load_big_endian( input_bytes() ) >> window_bits;
+                        window_bits += static_cast< int >( 8u * n_bytes );
+                        skip_bytes( n_bytes );
+                    }
+                    else if( n_bytes_left )
+                    {
+                        const auto bytes   = input_bytes();
+                        const auto n_bytes = std::min( n_bytes_left, static_cast< size_t >( window_digits - window_bits ) / 8u );
+
+                        for( size_t i = 0u ; i < n_bytes ; ++i )
+                        {
+                            window_bits += 8;
+                            window      |= static_cast< WindowT >( bytes[ i ] ) << ( window_digits - window_bits );
+                        }
+
+                        skip_bytes( n_bytes );
+                    }
+
+                    return;
+                }
+            }
+        }
+
+        while( window_bits <= window_digits - data_digits && input != input_end )
+        {
+            window_bits += data_digits;
+            window      |= static_cast< WindowT >( detail::read< WordOrder >( input ) ) << ( window_digits - window_bits );
+        }
+    }
+
+    // Removes 'n_bits' from the window and returns them; 'n_bits' must be in the range [1, window_bits].
+    constexpr WindowT take( int n_bits )
+    {
+        const auto bits = window >> ( window_digits - n_bits );
+
+        window       = n_bits < window_digits ? window << n_bits : WindowT{};
+        window_bits -= n_bits;
+
+        return bits;
+    }
+
+    // Decodes a value of which the codeword is not completely buffered in the window.
+    template< std::integral OutputValueT >
+    [[nodiscard]] decoder_result< OutputValueT > constexpr pull_parts( int k )
     {
         using UnsignedOutputValueT = typename std::make_unsigned< OutputValueT >::type;
-        using CommonT              = typename std::common_type< InputDataT, UnsignedOutputValueT >::type;
 
         constexpr auto max_value_digits = std::numeric_limits< UnsignedOutputValueT >::digits;
 
-        static_assert( k < max_value_digits );
-
         // Scan zeros
-        size_t zeros = {};
-        do
+        size_t zeros   = {};
+        int    counted = std::countl_zero( window );
+        while( counted >= window_bits )
         {
-            if( !check_data() )
+            zeros += window_bits;
+            if( window_bits )
             {
-                return { {}, decoder_status::done };
+                take( window_bits );
             }
 
-            const auto bit_width = std::bit_width( data );
-            const auto counted   = data_bits_remaining - bit_width;
+            refill();
+            if( !window_bits )
+            {
+                return { {}, decoder_status::done };
+            }
 
-            zeros               += counted;
-            data_bits_remaining  = bit_width;
+            counted = std::countl_zero( window );
         }
-        while( !data );
 
-        // Skip and clear the '1' that followed the zeros
-        data_bits_remaining -= 1;
-        data                &= ~( static_cast< InputDataT >( 1u ) << data_bits_remaining );
+        // Skip the '1' that followed the zeros
+        take( counted + 1 );
+        zeros += counted;
 
-        size_t digits = zeros + k;
+        size_t digits = zeros + static_cast< size_t >( k );
         if( digits > max_value_digits )
         {
             constexpr auto max_output_value = std::numeric_limits< OutputValueT >::max();
@@ -556,42 +1161,139 @@ public:
 
         // Read value
         UnsignedOutputValueT buffer = {};
-        do
+        while( digits )
         {
-            if( digits && !check_data() )
+            refill();
+            if( !window_bits )
             {
                 return { {}, decoder_status::done };
             }
 
-            if( digits >= data_bits_remaining )
-            {
-                const auto shift = digits - data_bits_remaining;
+            const auto n_bits = static_cast< int >( std::min( digits, static_cast< size_t >( window_bits ) ) );
+
+            buffer  = static_cast< UnsignedOutputValueT >( n_bits < max_value_digits ? buffer << n_bits : 0u );
+            buffer |= static_cast< UnsignedOutputValueT >( take( n_bits ) );
+            digits -= n_bits;
+        }
 
-                buffer |= static_cast< CommonT >( data ) << shift;
+        const auto base           = detail::make_mask< UnsignedOutputValueT >( zeros ) << k;
+        const auto buffered_value = static_cast< UnsignedOutputValueT >( buffer + base );
+        const auto value          = to_integral< OutputValueT >( buffered_value );
 
-                digits              -= data_bits_remaining;
-                data_bits_remaining  = {};
-            }
-            else
-            {
-                const auto shift = data_bits_remaining - digits;
+        return { value, decoder_status::success };
+    }
+
+    // Decodes a value with order 'k', 'k' must be smaller than the number of binary digits of 'OutputValueT'.
+    // Like the encoder's 'put_value', 'k' is an int or an std::integral_constant.
+    template< std::integral OutputValueT, typename OrderT >
+    [[nodiscard]] decoder_result< OutputValueT > constexpr pull_value( OrderT k )
+    {
+        using UnsignedOutputValueT = typename std::make_unsigned< OutputValueT >::type;
+
+        constexpr auto max_value_digits = std::numeric_limits< UnsignedOutputValueT >::digits;
+
+        refill();
+
+        // The codeword consists of the zeros followed by as many bits plus the order
+        const auto zeros  = std::countl_zero( window );
+        const auto length = 2 * zeros + k + 1;
 
-                buffer              |= data >> shift;
-                data_bits_remaining -= digits;
-                digits               = {};
+        if( length <= window_bits && zeros + k <= max_value_digits ) [[likely]]
+        {
+            const auto base           = static_cast< WindowT >( 1u ) << k;
+            const auto buffered_value = static_cast< UnsignedOutputValueT >( take( length ) - base );
+            const auto value          = to_integral< OutputValueT >( buffered_value );
+
+            return { value, decoder_status::success };
+        }
+
+        return pull_parts< OutputValueT >( k );
+    }
 
-                const auto mask = detail::make_mask< InputDataT >( data_bits_remaining );
+    template< std::integral OutputValueT, typename OrderT >
+    [[nodiscard]] decoder_batch_result constexpr pull_n_values( std::span< OutputValueT > output, OrderT k )
+    {
+        size_t count = {};
+        for( ; count < output.size() ; ++count )
+        {
+            if constexpr( detail::has_small_tables< OrderT > )
+            {
+                // Decodes the complete codewords in the next bits at once
+                refill();
+                if( window_bits >= detail::small_table_bits )
+                {
+                    const auto& [ values, n_values, length ] = detail::small_decode_table< OrderT::value >[ window >> ( window_digits - detail::small_table_bits ) ];
+                    if( n_values && values.size() <= output.size() - count )
+                    {
+                        // All the values of the entry are copied; the ones past 'n_values' are overwritten later
+                        for( size_t i = 0u ; i < values.size() ; ++i )
+                        {
+                            output[ count + i ] = to_integral< OutputValueT >( values[ i ] );
+                        }
+
+                        take( length );
+                        count += n_values - 1u;
+                        continue;
+                    }
+                }
+            }
 
-                data &= mask;
+            const auto [ value, status ] = pull_value< OutputValueT >( k );
+            if( status != decoder_status::success )
+            {
+                return { count, status };
             }
+
+            output[ count ] = value;
         }
-        while( digits );
 
-        const auto base           = detail::make_mask< UnsignedOutputValueT >( zeros ) << k;
-        const auto buffered_value = static_cast< UnsignedOutputValueT >( buffer + base );
-        const auto value          = to_integral< OutputValueT >( buffered_value );
+        return { count, decoder_status::success };
+    }
 
-        return { value, decoder_status::success };
+    template< std::integral OutputValueT >
+    static constexpr int clamp_order( size_t k )
+    {
+        using UnsignedOutputValueT = typename std::make_unsigned< OutputValueT >::type;
+
+        constexpr auto max_k = static_cast< size_t >( std::numeric_limits< UnsignedOutputValueT >::digits - 1 );
+
+        return static_cast< int >( std::min( k, max_k ) );
+    }
+
+public:
+    /**
+     * \brief Construct the decoder
+     *
+     * \param input      Begin iterator of the decoder's input containing encoded golomb data.
+     * \param input_end  End iterator that marks the end of the input data.
+     */
+    [[nodiscard]] constexpr decoder( InputIt input_, InputIt input_end_ )
+        : input_begin( input_ )
+        , input( input_ )
+        , input_end( input_end_ )
+        , window( WindowT{} )
+        , window_bits( 0 )
+        , input_offset( 0u )
+    {}
+
+    /**
+     * \brief Reads data from its input and returns a decoded result
+     *
+     * \tparam OutputValueT  Type of the value that is pulled
+     * \tparam k             Order of the golomb data to decode for the value that is pulled
+     *
+     * \note \em k should be smaler than the \em OutputValueT's maximum number of binary digits.
+     *
+     * \return A \em decoder_result struct containing the decoded value and/or decoder status
+     */
+    template< std::integral OutputValueT, size_t k = {} >
+    [[nodiscard]] decoder_result< OutputValueT > constexpr pull()
+    {
+        using UnsignedOutputValueT = typename std::make_unsigned< OutputValueT >::type;
+
+        static_assert( k < std::numeric_limits< UnsignedOutputValueT >::digits );
+
+        return pull_value< OutputValueT >( std::integral_constant< int, static_cast< int >( k ) >{} );
     }
 
     /**
@@ -608,30 +1310,92 @@ public:
     template< std::integral OutputValueT >
     [[nodiscard]] constexpr auto pull( size_t k )
     {
-        return pull_switch< OutputValueT >( k );
+        return pull_value< OutputValueT >( clamp_order< OutputValueT >( k ) );
     }
 
     /**
-     * \brief Checks if the decoder has ready data to decode
+     * \brief Decodes values from its input until \em output is filled or decoding did not succeed
      *
-     * \return True when the decoder has data buffered or has not yet reached the end of its input
+     * \tparam OutputValueT  Type of the values that are pulled
+     * \tparam k             Order of the golomb data to decode for the values that are pulled
      *
-     * \note The function returns true in case input contains but which is not enough to decode a valid value.
+     * \param output  The span to which the decoded values are written
+     *
+     * \note \em k should be smaler than the \em OutputValueT's maximum number of binary digits.
+     *
+     * \return A \em decoder_batch_result struct containing the number of values written to output and the status
+     *         of the last pull. The status is \em success when \em output is filled.
      */
-    [[nodiscard]] constexpr bool has_data() const
+    template< std::integral OutputValueT, size_t k = {} >
+    [[nodiscard]] decoder_batch_result constexpr pull_n( std::span< OutputValueT > output )
     {
-        return data_bits_remaining || input != input_end;
+        using UnsignedOutputValueT = typename std::make_unsigned< OutputValueT >::type;
+
+        static_assert( k < std::numeric_limits< UnsignedOutputValueT >::digits );
+
+        return pull_n_values( output, std::integral_constant< int, static_cast< int >( k ) >{} );
     }
-};
 
-/**
- * \brief Decodes binary golomb data from an input with a specified golomb order 
- *
- * \tparam OutputDataT The integral type of the decoded values
- *
- * \param input   The input iterator from which the read binary golomb data is read from
- * \param last    The iterator that marks the end of input range
- * \param output  The output iterator to which the decoded values are written
+    /**
+     * \overload pull_n( std::span< OutputValueT > output )
+     *
+     * \tparam  OutputValueT  Type of the values that are pulled
+     *
+     * \param output  The span to which the decoded values are written
+     * \param k       Order of the golomb data to decode for the values that are pulled
+     *
+     * \note \em k should be smaler than the \em OutputValueT's maximum number of binary digits.
+     */
+    template< std::integral OutputValueT >
+    [[nodiscard]] decoder_batch_result constexpr pull_n( std::span< OutputValueT > output, size_t k )
+    {
+        // The small orders use lookup tables
+        switch( k )
+        {
+        case 0u: return pull_n_values( output, std::integral_constant< int, 0 >{} );
+        case 1u: return pull_n_values( output, std::integral_constant< int, 1 >{} );
+        case 2u: return pull_n_values( output, std::integral_constant< int, 2 >{} );
+        default: return pull_n_values( output, clamp_order< OutputValueT >( k ) );
+        }
+    }
+
+    /**
+     * \brief Checks if the decoder has ready data to decode
+     *
+     * \return True when the decoder has data buffered or has not yet reached the end of its input
+     *
+     * \note The function returns true in case input contains but which is not enough to decode a valid value.
+     */
+    [[nodiscard]] constexpr bool has_data() const
+    {
+        return window_bits || input != input_end;
+    }
+
+    /**
+     * \brief Returns the number of bits from the begin of the input to the start of the next codeword
+     *
+     * The bit position after a successful pull is the end of the value's codeword. Decoders that start at different
+     * positions of the same data decode the same values once they reach the same bit position.
+     *
+     * \note Only available for random access input iterators.
+     */
+    [[nodiscard]] constexpr size_t bit_position() const
+    requires std::random_access_iterator< InputIt >
+    {
+        const auto n_words = static_cast< size_t >( input - input_begin );
+
+        return n_words * data_digits + 8u * input_offset - static_cast< size_t >( window_bits );
+    }
+};
+
+/**
+ * \brief Decodes binary golomb data from an input with a specified golomb order 
+ *
+ * \tparam OutputDataT The integral type of the decoded values
+ *
+ * \param input   The input iterator from which the read binary golomb data is read from
+ * \param last    The iterator that marks the end of input range
+ * \param output  The output iterator to which the decoded values are written
  * \param k       The order the values in the golomb data are encoded
  *
  * \note Be sure the values encoded in the golomb data fits within value range of \em OutputDataT.
@@ -679,4 +1443,2405 @@ constexpr auto decode( InputRangeT input, OutputIt output, size_t k = 0u )
     return decode< OutputValueT >( std::begin( input ), std::end( input ), output, k );
 }
 
+/**
+ * \brief Decodes binary golomb data from an input with a specified golomb order into a span
+ *
+ * \tparam OutputValueT The integral type of the decoded values
+ *
+ * \param input   The input iterator from which the read binary golomb data is read from
+ * \param last    The iterator that marks the end of input range
+ * \param output  The span to which the decoded values are written
+ * \param k       The order the values in the golomb data are encoded
+ *
+ * \note Be sure the values encoded in the golomb data fits within value range of \em OutputValueT.
+ *
+ * \note You must decode the binary golomb data with the same order as it is encoded.
+ *
+ * \return A \em decoder_batch_result struct containing the number of values written to output.
+ *         The status is \em success when output is filled before the end of the input is reached or
+ *         \em done when all the input is decoded.
+ */
+template< std::integral OutputValueT,
+          detail::unsigned_integral_input_iterator InputIt >
+constexpr decoder_batch_result decode_into( InputIt input, InputIt last, std::span< OutputValueT > output, size_t k = {} )
+{
+    decoder d( input, last );
+
+    size_t count = {};
+    while( true )
+    {
+        const auto [ n, status ] = d.template pull_n< OutputValueT >( output.subspan( count ), k );
+
+        count += n;
+        if( status != decoder_status::zero_overflow )
+        {
+            return { count, status };
+        }
+    }
+}
+
+/**
+ * \overload decode_into( InputIt input, InputIt last, std::span< OutputValueT > output, size_t k = {} )
+ *
+ * \tparam OutputValueT The integral type of the decoded values
+ *
+ * \param input  An input range to read binary golomb data from
+ * \param output The span to which the decoded values are written
+ * \param k      The order in which the data from input is encoded
+ */
+template< std::integral OutputValueT,
+          detail::unsigned_integral_input_range InputRangeT >
+constexpr decoder_batch_result decode_into( InputRangeT input, std::span< OutputValueT > output, size_t k = {} )
+{
+    return decode_into< OutputValueT >( std::begin( input ), std::end( input ), output, k );
+}
+
+
+/**
+ * \brief Golomb decoder that decodes golomb data which is received in successive chunks
+ *
+ * The chunks are decoded in place. When a chunk ends in the middle of a codeword \em need_input is returned and the
+ * unconsumed words of the chunk are copied to a small internal buffer, so that the chunk doesn't need to stay valid.
+ * The decoding continues where it stopped after the next chunk is fed. No memory is allocated.
+ *
+ * \tparam InputDataT  The type of the words of the chunks
+ *
+ * \note Values are limited to 64 binary digits.
+ */
+template< std::unsigned_integral InputDataT = uint8_t >
+class stream_decoder
+{
+    using DecoderT = decoder< const InputDataT * >;
+
+    static constexpr auto data_digits = std::numeric_limits< InputDataT >::digits;
+
+    // Number of words that hold the longest codeword of a 64 bit value
+    static constexpr size_t codeword_words = ( 2u * 64u + 1u + data_digits - 1u ) / data_digits;
+
+    DecoderT                                      d;
+    std::span< const InputDataT >                 chunk;
+    std::array< InputDataT, codeword_words >      carry;
+    std::array< InputDataT, 2u * codeword_words > scratch;
+    size_t                                        carry_size;
+    size_t                                        scratch_carry_size;   // Number of carried words at the begin of 'scratch' when decoding from 'scratch'
+    bool                                          finished;
+
+    // Continues in the chunk when all carried words are loaded in the window
+    constexpr void leave_scratch()
+    {
+        if( scratch_carry_size )
+        {
+            const auto position = static_cast< size_t >( d.input - scratch.data() );
+            if( position >= scratch_carry_size )
+            {
+                d.input            = chunk.data() + ( position - scratch_carry_size );
+                d.input_end        = chunk.data() + chunk.size();
+                scratch_carry_size = 0u;
+            }
+        }
+    }
+
+    template< std::integral OutputValueT, typename PullT >
+    [[nodiscard]] constexpr decoder_result< OutputValueT > pull_resumable( const PullT & pull )
+    {
+        using UnsignedOutputValueT = typename std::make_unsigned< OutputValueT >::type;
+
+        static_assert( std::numeric_limits< UnsignedOutputValueT >::digits <= 64 );
+
+        leave_scratch();
+
+        const auto saved  = d;
+        const auto result = pull( d );
+        if( result.status != decoder_status::done || finished )
+        {
+            return result;
+        }
+
+        // Restore the state before the incomplete codeword and keep the rest of the input for the next chunk
+        const auto remaining = static_cast< size_t >( saved.input_end - saved.input );
+        if( remaining > carry.size() )
+        {
+            // The zeros exceed the longest codeword, the input is not valid golomb data and is skipped
+            return { std::numeric_limits< OutputValueT >::max(), decoder_status::zero_overflow };
+        }
+
+        d          = saved;
+        carry_size = remaining;
+        std::copy( d.input, d.input_end, carry.begin() );
+
+        d.input            = carry.data();
+        d.input_end        = carry.data() + carry_size;
+        scratch_carry_size = 0u;
+
+        return { {}, decoder_status::need_input };
+    }
+
+public:
+    /**
+     * \brief Construct the stream decoder without input
+     */
+    constexpr stream_decoder()
+        : d( nullptr, nullptr )
+        , chunk()
+        , carry()
+        , scratch()
+        , carry_size( 0u )
+        , scratch_carry_size( 0u )
+        , finished( false )
+    {}
+
+    /**
+     * \brief Sets the next chunk of input
+     *
+     * \param next_chunk  The chunk, it must stay valid until a pull returns \em need_input
+     *
+     * \note Feed the next chunk only after a pull returned \em need_input.
+     */
+    constexpr void feed( std::span< const InputDataT > next_chunk )
+    {
+        chunk = next_chunk;
+
+        if( carry_size )
+        {
+            // The carried words and the begin of the chunk are decoded from the scratch buffer
+            const auto n_words = std::min( chunk.size(), scratch.size() - carry_size );
+
+            std::copy( carry.begin(), carry.begin() + carry_size, scratch.begin() );
+            std::copy( chunk.begin(), chunk.begin() + n_words, scratch.begin() + carry_size );
+
+            d.input            = scratch.data();
+            d.input_end        = scratch.data() + carry_size + n_words;
+            scratch_carry_size = carry_size;
+            carry_size         = 0u;
+        }
+        else
+        {
+            d.input     = chunk.data();
+            d.input_end = chunk.data() + chunk.size();
+        }
+    }
+
+    /**
+     * \brief Marks the end of the input, after which a pull returns \em done instead of \em need_input
+     */
+    constexpr void finish()
+    {
+        finished = true;
+    }
+
+    /**
+     * \brief Decodes a value from the input
+     *
+     * \tparam OutputValueT  Type of the value that is pulled
+     * \tparam k             Order of the golomb data to decode for the value that is pulled
+     *
+     * \return A \em decoder_result struct containing the decoded value and/or decoder status
+     */
+    template< std::integral OutputValueT, size_t k = {} >
+    [[nodiscard]] constexpr decoder_result< OutputValueT > pull()
+    {
+        return pull_resumable< OutputValueT >( []( DecoderT & d ) { return d.template pull< OutputValueT, k >(); } );
+    }
+
+    /**
+     * \overload pull()
+     *
+     * \param k  Order of the golomb data to decode for the value that is pulled
+     */
+    template< std::integral OutputValueT >
+    [[nodiscard]] constexpr decoder_result< OutputValueT > pull( size_t k )
+    {
+        return pull_resumable< OutputValueT >( [ k ]( DecoderT & d ) { return d.template pull< OutputValueT >( k ); } );
+    }
+
+    /**
+     * \brief Decodes values until \em output is filled or decoding did not succeed
+     *
+     * \param output  The span to which the decoded values are written
+     * \param k       Order of the golomb data to decode for the values that are pulled
+     *
+     * \return A \em decoder_batch_result struct containing the number of values written to output and the status
+     *         of the last pull. The status is \em success when \em output is filled.
+     */
+    template< std::integral OutputValueT >
+    [[nodiscard]] constexpr decoder_batch_result pull_n( std::span< OutputValueT > output, size_t k )
+    {
+        size_t count = {};
+        for( ; count < output.size() ; ++count )
+        {
+            const auto [ value, status ] = pull< OutputValueT >( k );
+            if( status != decoder_status::success )
+            {
+                return { count, status };
+            }
+
+            output[ count ] = value;
+        }
+
+        return { count, decoder_status::success };
+    }
+};
+
+/**
+ * \brief Filter shift of an \em ema_policy that is set at runtime
+ */
+inline constexpr size_t dynamic_shift = std::numeric_limits< size_t >::max();
+
+/**
+ * \brief Order of a \em fixed_order_policy that is set at runtime
+ */
+inline constexpr size_t dynamic_order = std::numeric_limits< size_t >::max();
+
+/**
+ * \brief Requirements for a policy that adapts the order of an adaptive encoder or decoder
+ *
+ * \em order returns the order for the next value. After each value \em update is called with the number of
+ * binary digits of the value in its unsigned representation, see \em to_unsigned.
+ * The encoder and decoder must use policies with the same state to produce the same orders.
+ */
+template< typename PolicyT >
+concept adaptation_policy = std::copy_constructible< PolicyT > &&
+                            requires( PolicyT policy, const PolicyT & const_policy, size_t digits )
+{
+    { const_policy.order() } -> std::convertible_to< size_t >;
+    policy.update( digits );
+};
+
+/**
+ * \brief Adapts the order with an exponential smoothing filter; k = k - ( k >> Shift ) + ( digits >> Shift )
+ *
+ * \tparam Shift  Filter shift, the filter factor is 2^Shift. Use \em dynamic_shift to set the shift at runtime.
+ */
+template< size_t Shift >
+class ema_policy
+{
+    size_t k;
+    size_t shift;
+
+public:
+    /**
+     * \brief Construct the policy
+     *
+     * \param k  The initial order
+     */
+    constexpr ema_policy( size_t k = {} ) requires( Shift != dynamic_shift )
+        : k( k )
+        , shift( Shift )
+    {}
+
+    /**
+     * \brief Construct the policy with a filter shift that is set at runtime
+     *
+     * \param k      The initial order
+     * \param shift  The filter shift
+     */
+    constexpr ema_policy( size_t k, size_t shift ) requires( Shift == dynamic_shift )
+        : k( k )
+        , shift( shift )
+    {}
+
+    [[nodiscard]] constexpr size_t order() const
+    {
+        return k;
+    }
+
+    constexpr void update( size_t digits )
+    {
+        const auto s = Shift == dynamic_shift ? shift : Shift;
+
+        k = k - ( k >> s ) + ( digits >> s );
+    }
+};
+
+/**
+ * \brief Adapts the order with a filter that follows larger values faster than smaller values
+ *
+ * A value with 'digits' binary digits is encoded with the least bits at order 'digits - 1'. The order moves by
+ * 2^-AttackShift of the distance towards that order when it is larger and by 2^-DecayShift when it is smaller.
+ * The filter state has a fractional part so that small steps are not lost.
+ *
+ * \tparam AttackShift  Filter shift when the order increases
+ * \tparam DecayShift   Filter shift when the order decreases
+ */
+template< size_t AttackShift = 2u, size_t DecayShift = 4u >
+class attack_decay_policy
+{
+    static constexpr size_t fraction_digits = 8u;
+
+    size_t state;   // Order with 'fraction_digits' fractional digits
+
+public:
+    /**
+     * \brief Construct the policy
+     *
+     * \param k  The initial order
+     */
+    constexpr attack_decay_policy( size_t k = {} )
+        : state( k << fraction_digits )
+    {}
+
+    [[nodiscard]] constexpr size_t order() const
+    {
+        return state >> fraction_digits;
+    }
+
+    constexpr void update( size_t digits )
+    {
+        const auto target = ( digits ? digits - 1u : 0u ) << fraction_digits;
+        if( target > state )
+        {
+            state += ( target - state + ( size_t{ 1u } << AttackShift ) - 1u ) >> AttackShift;
+        }
+        else
+        {
+            state -= ( state - target ) >> DecayShift;
+        }
+    }
+};
+
+/**
+ * \brief Keeps the order the same for all values
+ *
+ * Used for the lanes of a \em multi_lane_encoder and \em multi_lane_decoder that don't adapt their order.
+ *
+ * \tparam K  The order, use \em dynamic_order to set the order at runtime.
+ */
+template< size_t K >
+class fixed_order_policy
+{
+    size_t k;
+
+public:
+    /**
+     * \brief Construct the policy
+     */
+    constexpr fixed_order_policy() requires( K != dynamic_order )
+        : k( K )
+    {}
+
+    /**
+     * \brief Construct the policy with an order that is set at runtime
+     *
+     * \param k  The order
+     */
+    constexpr fixed_order_policy( size_t k ) requires( K == dynamic_order )
+        : k( k )
+    {}
+
+    [[nodiscard]] constexpr size_t order() const
+    {
+        return K == dynamic_order ? k : K;
+    }
+
+    constexpr void update( size_t )
+    {}
+};
+
+/**
+ * \brief Golomb encoder that adapts the order to the values it encodes
+ *
+ * Each value is encoded with the order of the policy after which the policy is updated with the value.
+ *
+ * \tparam OutputIt     Type of the output iterator to which the encoded words are written
+ * \tparam PolicyT      The policy that adapts the order, see \em adaptation_policy
+ * \tparam OutputDataT  The type of the words written to the output
+ */
+template< typename OutputIt, adaptation_policy PolicyT, std::unsigned_integral OutputDataT = uint8_t >
+requires std::output_iterator< OutputIt, OutputDataT >
+class basic_adaptive_encoder
+{
+    encoder< OutputIt, OutputDataT > e;
+    PolicyT                          policy;
+
+public:
+    /**
+     * \brief Construct the adaptive encoder
+     *
+     * \param output       Output iterator to which the encoded values are written
+     * \param policy_args  The arguments to construct the policy with, for example the initial order
+     */
+    template< typename... PolicyArgsT >
+    requires std::constructible_from< PolicyT, PolicyArgsT... >
+    constexpr basic_adaptive_encoder( OutputIt output, PolicyArgsT... policy_args )
+        : e( output )
+        , policy( policy_args... )
+    {}
+
+    /**
+     * \brief Encodes the given value with the current order and adapts the order to the value
+     *
+     * \param x  The value to encode
+     *
+     * \return The output iterator one past the data that has been written to the output
+     */
+    template< std::integral InputValueT >
+    constexpr OutputIt push( InputValueT x )
+    {
+        const auto unsigned_value = to_unsigned( x );
+        const auto position       = e.push( unsigned_value, policy.order() );
+
+        policy.update( static_cast< size_t >( std::bit_width( unsigned_value ) ) );
+
+        return position;
+    }
+
+    /**
+     * \brief Flushes the internal bitbuffer to output
+     *
+     * \return The output iterator one past the data that has been flushed to the output
+     */
+    constexpr OutputIt flush()
+    {
+        return e.flush();
+    }
+
+    /**
+     * \brief Returns the order with which the next value is encoded
+     */
+    [[nodiscard]] constexpr size_t order() const
+    {
+        return policy.order();
+    }
+
+    /**
+     * \brief Returns the number of \em OutputDataT words that are written to the output
+     */
+    [[nodiscard]] constexpr size_t size() const
+    {
+        return e.size();
+    }
+};
+
+/**
+ * \brief Golomb encoder that adapts the order with an exponential smoothing filter, see \em ema_policy
+ *
+ * \tparam OutputIt     Type of the output iterator to which the encoded words are written
+ * \tparam Shift        Filter shift, the filter factor is 2^Shift. Use \em dynamic_shift to set the shift at runtime.
+ * \tparam OutputDataT  The type of the words written to the output
+ */
+template< typename OutputIt, size_t Shift, std::unsigned_integral OutputDataT = uint8_t >
+using adaptive_encoder = basic_adaptive_encoder< OutputIt, ema_policy< Shift >, OutputDataT >;
+
+/**
+ * \brief Golomb decoder that adapts the order to the values it decodes
+ *
+ * The counterpart of \em basic_adaptive_encoder, the data must be decoded with a policy in the same initial state
+ * as it is encoded with.
+ *
+ * \tparam InputIt  Type of the input iterator from which the encoded words are read
+ * \tparam PolicyT  The policy that adapts the order, see \em adaptation_policy
+ */
+template< detail::unsigned_integral_input_iterator InputIt, adaptation_policy PolicyT >
+class basic_adaptive_decoder
+{
+    decoder< InputIt > d;
+    PolicyT            policy;
+
+public:
+    /**
+     * \brief Construct the adaptive decoder
+     *
+     * \param input        Begin iterator of the decoder's input containing encoded golomb data.
+     * \param input_end    End iterator that marks the end of the input data.
+     * \param policy_args  The arguments to construct the policy with, for example the initial order
+     */
+    template< typename... PolicyArgsT >
+    requires std::constructible_from< PolicyT, PolicyArgsT... >
+    [[nodiscard]] constexpr basic_adaptive_decoder( InputIt input, InputIt input_end, PolicyArgsT... policy_args )
+        : d( input, input_end )
+        , policy( policy_args... )
+    {}
+
+    /**
+     * \brief Decodes a value with the current order and adapts the order to the value
+     *
+     * \tparam OutputValueT  Type of the value that is pulled
+     *
+     * \return A \em decoder_result struct containing the decoded value and/or decoder status.
+     *         The order is only adapted when the status is \em success.
+     */
+    template< std::integral OutputValueT >
+    [[nodiscard]] constexpr decoder_result< OutputValueT > pull()
+    {
+        using UnsignedOutputValueT = typename std::make_unsigned< OutputValueT >::type;
+
+        const auto [ value, status ] = d.template pull< UnsignedOutputValueT >( policy.order() );
+        if( status == decoder_status::success )
+        {
+            policy.update( static_cast< size_t >( std::bit_width( value ) ) );
+
+            return { to_integral< OutputValueT >( value ), status };
+        }
+
+        return { static_cast< OutputValueT >( value ), status };
+    }
+
+    /**
+     * \brief Decodes values until \em output is filled or decoding did not succeed
+     *
+     * \tparam OutputValueT  Type of the values that are pulled
+     *
+     * \param output  The span to which the decoded values are written
+     *
+     * \return A \em decoder_batch_result struct containing the number of values written to output and the status
+     *         of the last pull. The status is \em success when \em output is filled.
+     */
+    template< std::integral OutputValueT >
+    [[nodiscard]] constexpr decoder_batch_result pull_n( std::span< OutputValueT > output )
+    {
+        size_t count = {};
+        for( ; count < output.size() ; ++count )
+        {
+            const auto [ value, status ] = pull< OutputValueT >();
+            if( status != decoder_status::success )
+            {
+                return { count, status };
+            }
+
+            output[ count ] = value;
+        }
+
+        return { count, decoder_status::success };
+    }
+
+    /**
+     * \brief Returns the order with which the next value is decoded
+     */
+    [[nodiscard]] constexpr size_t order() const
+    {
+        return policy.order();
+    }
+
+    /**
+     * \brief Checks if the decoder has ready data to decode
+     */
+    [[nodiscard]] constexpr bool has_data() const
+    {
+        return d.has_data();
+    }
+};
+
+/**
+ * \brief Golomb decoder that adapts the order with an exponential smoothing filter, see \em ema_policy
+ *
+ * \tparam InputIt  Type of the input iterator from which the encoded words are read
+ * \tparam Shift    Filter shift, the filter factor is 2^Shift. Use \em dynamic_shift to set the shift at runtime.
+ */
+template< detail::unsigned_integral_input_iterator InputIt, size_t Shift >
+using adaptive_decoder = basic_adaptive_decoder< InputIt, ema_policy< Shift > >;
+
+/**
+ * \brief Encodes integral values from an input while adapting the order to the encoded values
+ *
+ * \tparam Shift  Filter shift of the adaptive order, see \em adaptive_encoder
+ *
+ * \param input  An input iterator to read integral values from
+ * \param last   The iterator that marks the end of input range
+ * \param output The output iterator to which the ecoded values are written
+ * \param k      The initial order
+ */
+template< size_t Shift,
+          std::unsigned_integral OutputDataT = uint8_t,
+          detail::integral_input_iterator InputIt,
+          typename OutputIt >
+requires std::output_iterator< OutputIt, OutputDataT > && ( Shift != dynamic_shift )
+constexpr auto adaptive_encode( InputIt input, InputIt last, OutputIt output, size_t k = {} )
+{
+    using ValueT = typename std::iterator_traits< InputIt >::value_type;
+
+    adaptive_encoder< OutputIt, Shift, OutputDataT > e( output, k );
+
+    while( input != last )
+    {
+        e.push( static_cast< ValueT >( *input++ ) );
+    }
+
+    return e.flush();
+}
+
+/**
+ * \overload adaptive_encode( InputIt input, InputIt last, OutputIt output, size_t k = {} )
+ *
+ * \param input  A range to read integral values from that are encoded
+ * \param output The output iterator to which the ecoded values are written
+ * \param k      The initial order
+ */
+template< size_t Shift,
+          std::unsigned_integral OutputDataT = uint8_t,
+          detail::integral_input_range InputRangeT,
+          typename OutputIt >
+requires std::output_iterator< OutputIt, OutputDataT > && ( Shift != dynamic_shift )
+constexpr auto adaptive_encode( InputRangeT input, OutputIt output, size_t k = {} )
+{
+    using InputValueT = std::ranges::range_value_t< InputRangeT >;
+
+    adaptive_encoder< OutputIt, Shift, OutputDataT > e( output, k );
+
+    for( const auto& value : input )
+    {
+        e.push( static_cast< InputValueT >( value ) );
+    }
+
+    return e.flush();
+}
+
+/**
+ * \brief Decodes binary golomb data that is encoded with an adaptive order
+ *
+ * \tparam OutputValueT The integral type of the decoded values
+ * \tparam Shift        Filter shift of the adaptive order, see \em adaptive_encoder
+ *
+ * \param input  The input iterator from which the read binary golomb data is read from
+ * \param last   The iterator that marks the end of input range
+ * \param output The output iterator to which the decoded values are written
+ * \param k      The initial order
+ */
+template< std::integral OutputValueT,
+          size_t Shift,
+          detail::unsigned_integral_input_iterator InputIt,
+          typename OutputIt >
+requires std::output_iterator< OutputIt , OutputValueT > && ( Shift != dynamic_shift )
+constexpr auto adaptive_decode( InputIt input, InputIt last, OutputIt output, size_t k = {} )
+{
+    adaptive_decoder< InputIt, Shift > d( input, last, k );
+
+    while( d.has_data() )
+    {
+        const auto [ value, status ] = d.template pull< OutputValueT >();
+        if( status == decoder_status::success )
+        {
+            *output++ = value;
+        }
+    }
+
+    return output;
+}
+
+/**
+ * \overload adaptive_decode( InputIt input, InputIt last, OutputIt output, size_t k = {} )
+ *
+ * \param input  An input range to read binary golomb data from
+ * \param output The output iterator to which the decoded values are written
+ * \param k      The initial order
+ */
+template< std::integral OutputValueT,
+          size_t Shift,
+          detail::unsigned_integral_input_range InputRangeT,
+          typename OutputIt >
+requires std::output_iterator< OutputIt , OutputValueT > && ( Shift != dynamic_shift )
+constexpr auto adaptive_decode( InputRangeT input, OutputIt output, size_t k = {} )
+{
+    return adaptive_decode< OutputValueT, Shift >( std::begin( input ), std::end( input ), output, k );
+}
+
+/**
+ * \brief Encodes integral values from a range while the order is adapted by a policy
+ *
+ * \param input   A range to read integral values from that are encoded
+ * \param output  The output iterator to which the ecoded values are written
+ * \param policy  The policy that adapts the order, see \em adaptation_policy
+ */
+template< std::unsigned_integral OutputDataT = uint8_t,
+          detail::integral_input_range InputRangeT,
+          typename OutputIt,
+          adaptation_policy PolicyT >
+requires std::output_iterator< OutputIt, OutputDataT >
+constexpr auto adaptive_encode( InputRangeT input, OutputIt output, PolicyT policy )
+{
+    using InputValueT = std::ranges::range_value_t< InputRangeT >;
+
+    basic_adaptive_encoder< OutputIt, PolicyT, OutputDataT > e( output, policy );
+
+    for( const auto& value : input )
+    {
+        e.push( static_cast< InputValueT >( value ) );
+    }
+
+    return e.flush();
+}
+
+/**
+ * \brief Decodes binary golomb data of which the order is adapted by a policy
+ *
+ * \tparam OutputValueT The integral type of the decoded values
+ *
+ * \param input   An input range to read binary golomb data from
+ * \param output  The output iterator to which the decoded values are written
+ * \param policy  The policy that adapts the order, must be in the same state as the policy used for encoding
+ */
+template< std::integral OutputValueT,
+          detail::unsigned_integral_input_range InputRangeT,
+          typename OutputIt,
+          adaptation_policy PolicyT >
+requires std::output_iterator< OutputIt , OutputValueT >
+constexpr auto adaptive_decode( InputRangeT input, OutputIt output, PolicyT policy )
+{
+    using InputIt = decltype( std::begin( input ) );
+
+    basic_adaptive_decoder< InputIt, PolicyT > d( std::begin( input ), std::end( input ), policy );
+
+    while( d.has_data() )
+    {
+        const auto [ value, status ] = d.template pull< OutputValueT >();
+        if( status == decoder_status::success )
+        {
+            *output++ = value;
+        }
+    }
+
+    return output;
+}
+
+/**
+ * \brief Golomb encoder that encodes records of which each field has its own order
+ *
+ * Each field of a record is encoded in its own lane with its own policy for the order, see \em adaptation_policy.
+ * The fields of a record are encoded after each other in lane order in a single bitstream. This results in the same
+ * data as pushing the fields to one \em encoder with the order of their lane.
+ *
+ * \tparam OutputIt     Type of the output iterator to which the encoded words are written
+ * \tparam LanesT       An std::tuple with the policies of the lanes
+ * \tparam OutputDataT  The type of the words written to the output
+ */
+template< typename OutputIt, typename LanesT, std::unsigned_integral OutputDataT = uint8_t >
+requires std::output_iterator< OutputIt, OutputDataT >
+class multi_lane_encoder
+{
+    static constexpr auto n_lanes = std::tuple_size_v< LanesT >;
+
+    encoder< OutputIt, OutputDataT > e;
+    LanesT                           lanes;
+
+    template< adaptation_policy PolicyT, std::integral InputValueT >
+    constexpr OutputIt push_lane( PolicyT & policy, InputValueT x )
+    {
+        const auto unsigned_value = to_unsigned( x );
+        const auto position       = e.push( unsigned_value, policy.order() );
+
+        policy.update( static_cast< size_t >( std::bit_width( unsigned_value ) ) );
+
+        return position;
+    }
+
+public:
+    /**
+     * \brief Construct the multi lane encoder
+     *
+     * \param output  Output iterator to which the encoded records are written
+     * \param lanes   The policies of the lanes in their initial state
+     */
+    constexpr multi_lane_encoder( OutputIt output, LanesT lanes = {} )
+        : e( output )
+        , lanes( lanes )
+    {}
+
+    /**
+     * \brief Encodes a record
+     *
+     * \param fields  The fields of the record, one for each lane
+     *
+     * \return The output iterator one past the data that has been written to the output
+     */
+    template< std::integral... InputValueTs >
+    requires( sizeof...( InputValueTs ) == n_lanes )
+    constexpr OutputIt push( InputValueTs... fields )
+    {
+        // The fold evaluates the lanes in order and results in the position after the last lane
+        return [ & ]< size_t... Lanes >( std::index_sequence< Lanes... > )
+        {
+            return ( push_lane( std::get< Lanes >( lanes ), fields ), ... );
+        }( std::make_index_sequence< n_lanes >{} );
+    }
+
+    /**
+     * \brief Flushes the internal bitbuffer to output
+     *
+     * \return The output iterator one past the data that has been flushed to the output
+     */
+    constexpr OutputIt flush()
+    {
+        return e.flush();
+    }
+
+    /**
+     * \brief Returns the number of \em OutputDataT words that are written to the output
+     */
+    [[nodiscard]] constexpr size_t size() const
+    {
+        return e.size();
+    }
+};
+
+/**
+ * \brief Golomb decoder for records that are encoded by a \em multi_lane_encoder
+ *
+ * \tparam InputIt  Type of the input iterator from which the encoded words are read
+ * \tparam LanesT   An std::tuple with the policies of the lanes, in the same initial state as used for encoding
+ */
+template< detail::unsigned_integral_input_iterator InputIt, typename LanesT >
+class multi_lane_decoder
+{
+    static constexpr auto n_lanes = std::tuple_size_v< LanesT >;
+
+    decoder< InputIt > d;
+    LanesT             lanes;
+
+    template< adaptation_policy PolicyT, std::integral OutputValueT >
+    [[nodiscard]] constexpr bool pull_lane( PolicyT & policy, OutputValueT & x, decoder_status & status )
+    {
+        using UnsignedOutputValueT = typename std::make_unsigned< OutputValueT >::type;
+
+        const auto result = d.template pull< UnsignedOutputValueT >( policy.order() );
+
+        status = result.status;
+        if( status != decoder_status::success )
+        {
+            return false;
+        }
+
+        policy.update( static_cast< size_t >( std::bit_width( result.value ) ) );
+        x = to_integral< OutputValueT >( result.value );
+
+        return true;
+    }
+
+public:
+    /**
+     * \brief Construct the multi lane decoder
+     *
+     * \param input      Begin iterator of the decoder's input containing encoded golomb data.
+     * \param input_end  End iterator that marks the end of the input data.
+     * \param lanes      The policies of the lanes in their initial state
+     */
+    [[nodiscard]] constexpr multi_lane_decoder( InputIt input, InputIt input_end, LanesT lanes = {} )
+        : d( input, input_end )
+        , lanes( lanes )
+    {}
+
+    /**
+     * \brief Decodes a record
+     *
+     * The fields are decoded in lane order until a field could not be decoded successfully.
+     *
+     * \param fields  References to the fields of the record, one for each lane
+     *
+     * \return The status of the last decoded field, the record is complete when the status is \em success
+     */
+    template< std::integral... OutputValueTs >
+    requires( sizeof...( OutputValueTs ) == n_lanes )
+    [[nodiscard]] constexpr decoder_status pull( OutputValueTs &... fields )
+    {
+        auto status = decoder_status::success;
+
+        [ & ]< size_t... Lanes >( std::index_sequence< Lanes... > )
+        {
+            ( pull_lane( std::get< Lanes >( lanes ), fields, status ) && ... );
+        }( std::make_index_sequence< n_lanes >{} );
+
+        return status;
+    }
+
+    /**
+     * \brief Checks if the decoder has ready data to decode
+     */
+    [[nodiscard]] constexpr bool has_data() const
+    {
+        return d.has_data();
+    }
+};
+
+/**
+ * \brief Returns the number of bits of the codeword of a value without encoding it
+ *
+ * \param x  The value
+ * \param k  The order with which \em x is encoded
+ *
+ * \note \em k is limited to the \em InputValueT's maximum number of binary digits minus one.
+ */
+template< std::integral InputValueT >
+[[nodiscard]] constexpr size_t encoded_bits( InputValueT x, size_t k = {} )
+{
+    using UnsignedInputValueT = typename std::make_unsigned< InputValueT >::type;
+
+    constexpr auto max_k = static_cast< size_t >( std::numeric_limits< UnsignedInputValueT >::digits - 1 );
+
+    return detail::codeword_length( to_unsigned( x ), std::min( k, max_k ) );
+}
+
+/**
+ * \overload encoded_bits( InputValueT x, size_t k = {} )
+ *
+ * Returns the exact number of bits that the values of an input take when they are encoded, the padding of the last
+ * word by \em flush is not included.
+ *
+ * \param input  An input iterator to read integral values from
+ * \param last   The iterator that marks the end of input range
+ * \param k      The order with which the values are encoded
+ */
+template< detail::integral_input_iterator InputIt >
+[[nodiscard]] constexpr size_t encoded_bits( InputIt input, InputIt last, size_t k = {} )
+{
+    using ValueT = typename std::iterator_traits< InputIt >::value_type;
+
+    size_t bits = {};
+    for( ; input != last ; ++input )
+    {
+        bits += encoded_bits( static_cast< ValueT >( *input ), k );
+    }
+
+    return bits;
+}
+
+/**
+ * \overload encoded_bits( InputValueT x, size_t k = {} )
+ *
+ * \param input  A range to read integral values from
+ * \param k      The order with which the values are encoded
+ */
+template< detail::integral_input_range InputRangeT >
+[[nodiscard]] constexpr size_t encoded_bits( const InputRangeT & input, size_t k = {} )
+{
+    return encoded_bits( std::ranges::begin( input ), std::ranges::end( input ), k );
+}
+
+/**
+ * \brief Returns the exact number of bits that the values of an input take for every order in a single pass
+ *
+ * Element \em k of the returned array holds the number of bits of the values when they are encoded with order \em k.
+ * The lengths for all the orders are computed from each value in a loop with a fixed trip count that the compiler
+ * can vectorize; nothing is written to an output.
+ *
+ * \param input  An input iterator to read integral values from
+ * \param last   The iterator that marks the end of input range
+ */
+template< detail::integral_input_iterator InputIt >
+[[nodiscard]] constexpr auto encoded_bits_by_order( InputIt input, InputIt last )
+{
+    using ValueT              = typename std::iterator_traits< InputIt >::value_type;
+    using UnsignedInputValueT = typename std::make_unsigned< ValueT >::type;
+
+    constexpr auto value_digits = std::numeric_limits< UnsignedInputValueT >::digits;
+
+    std::array< size_t, value_digits > bits = {};
+    for( ; input != last ; ++input )
+    {
+        const auto u = to_unsigned( static_cast< ValueT >( *input ) );
+
+        for( int k = 0 ; k < value_digits ; ++k )
+        {
+            // Equals 'detail::codeword_length', a carry of the base makes the data one digit wider
+            const auto data       = static_cast< UnsignedInputValueT >( u + static_cast< UnsignedInputValueT >( static_cast< UnsignedInputValueT >( 1u ) << k ) );
+            const auto data_width = data < u ? value_digits + 1 : std::bit_width( data );
+
+            bits[ k ] += static_cast< size_t >( 2 * data_width - k - 1 );
+        }
+    }
+
+    return bits;
+}
+
+/**
+ * \overload encoded_bits_by_order( InputIt input, InputIt last )
+ *
+ * \param input  A range to read integral values from
+ */
+template< detail::integral_input_range InputRangeT >
+[[nodiscard]] constexpr auto encoded_bits_by_order( const InputRangeT & input )
+{
+    return encoded_bits_by_order( std::ranges::begin( input ), std::ranges::end( input ) );
+}
+
+/**
+ * \brief Returns the order with which the values of an input are encoded with the least number of bits
+ *
+ * The order is selected with the exact number of bits for every order, see \em encoded_bits_by_order.
+ * The lowest of the orders with the least bits is returned.
+ *
+ * \param input  A forward iterator to read integral values from
+ * \param last   The iterator that marks the end of input range
+ */
+template< detail::integral_input_iterator InputIt >
+requires std::forward_iterator< InputIt >
+[[nodiscard]] constexpr size_t optimal_order( InputIt input, InputIt last )
+{
+    const auto bits = encoded_bits_by_order( input, last );
+
+    return static_cast< size_t >( std::ranges::min_element( bits ) - bits.begin() );
+}
+
+/**
+ * \overload optimal_order( InputIt input, InputIt last )
+ *
+ * \param input  A forward range to read integral values from
+ */
+template< detail::integral_input_range InputRangeT >
+requires std::ranges::forward_range< InputRangeT >
+[[nodiscard]] constexpr size_t optimal_order( const InputRangeT & input )
+{
+    return optimal_order( std::ranges::begin( input ), std::ranges::end( input ) );
+}
+
+/**
+ * \brief Returns the exact number of bits that the values of an input take when they are encoded by an adaptive encoder
+ *
+ * The policy is updated with each value like \em basic_adaptive_encoder does, nothing is written to an output.
+ * The padding of the last word by \em flush is not included.
+ *
+ * \param input   An input iterator to read integral values from
+ * \param last    The iterator that marks the end of input range
+ * \param policy  The policy in the state with which the adaptive encoder starts
+ */
+template< detail::integral_input_iterator InputIt, adaptation_policy PolicyT >
+[[nodiscard]] constexpr size_t adaptive_encoded_bits( InputIt input, InputIt last, PolicyT policy )
+{
+    using ValueT = typename std::iterator_traits< InputIt >::value_type;
+
+    size_t bits = {};
+    for( ; input != last ; ++input )
+    {
+        const auto unsigned_value = to_unsigned( static_cast< ValueT >( *input ) );
+
+        bits += encoded_bits( unsigned_value, policy.order() );
+        policy.update( static_cast< size_t >( std::bit_width( unsigned_value ) ) );
+    }
+
+    return bits;
+}
+
+/**
+ * \overload adaptive_encoded_bits( InputIt input, InputIt last, PolicyT policy )
+ *
+ * \param input   A range to read integral values from
+ * \param policy  The policy in the state with which the adaptive encoder starts
+ */
+template< detail::integral_input_range InputRangeT, adaptation_policy PolicyT >
+[[nodiscard]] constexpr size_t adaptive_encoded_bits( const InputRangeT & input, PolicyT policy )
+{
+    return adaptive_encoded_bits( std::ranges::begin( input ), std::ranges::end( input ), policy );
+}
+
+/**
+ * \brief Requirements for a transform stage that preprocesses values before they are encoded
+ *
+ * \em forward transforms a value before it is encoded, \em inverse restores a value after it is decoded.
+ * Stages may keep state, are applied to the values in order and must be used with the same initial state
+ * for encoding and decoding. Signed results are mapped to unsigned values by the encoder, see \em to_unsigned.
+ */
+template< typename StageT >
+concept transform_stage = std::integral< typename StageT::value_type > &&
+                          std::integral< typename StageT::result_type > &&
+                          std::copy_constructible< StageT > &&
+                          requires( StageT stage, typename StageT::value_type x, typename StageT::result_type r )
+{
+    { stage.forward( x ) } -> std::same_as< typename StageT::result_type >;
+    { stage.inverse( r ) } -> std::same_as< typename StageT::value_type >;
+};
+
+/**
+ * \brief Transform stage that leaves the values unchanged, the default stage of a \em codec
+ *
+ * \tparam ValueT  The integral type of the values
+ */
+template< std::integral ValueT >
+class identity_transform
+{
+public:
+    using value_type  = ValueT;
+    using result_type = ValueT;
+
+    [[nodiscard]] constexpr result_type forward( value_type x ) const
+    {
+        return x;
+    }
+
+    [[nodiscard]] constexpr value_type inverse( result_type r ) const
+    {
+        return r;
+    }
+};
+
+/**
+ * \brief Transform stage that replaces a value by its difference with the previous value
+ *
+ * \tparam ValueT  The integral type of the values, differences are computed modulo 2^digits
+ */
+template< std::integral ValueT >
+class delta_transform
+{
+    using UnsignedValueT = typename std::make_unsigned< ValueT >::type;
+
+    ValueT previous;
+
+public:
+    using value_type  = ValueT;
+    using result_type = typename std::make_signed< ValueT >::type;
+
+    /**
+     * \param initial  The value that precedes the first value
+     */
+    constexpr delta_transform( ValueT initial = {} )
+        : previous( initial )
+    {}
+
+    [[nodiscard]] constexpr result_type forward( value_type x )
+    {
+        const auto d = static_cast< result_type >( static_cast< UnsignedValueT >( static_cast< UnsignedValueT >( x ) -
+                                                                                  static_cast< UnsignedValueT >( previous ) ) );
+        previous = x;
+
+        return d;
+    }
+
+    [[nodiscard]] constexpr value_type inverse( result_type d )
+    {
+        previous = static_cast< value_type >( static_cast< UnsignedValueT >( static_cast< UnsignedValueT >( previous ) +
+                                                                             static_cast< UnsignedValueT >( d ) ) );
+
+        return previous;
+    }
+};
+
+/**
+ * \brief Transform stage that replaces a value by the difference of its delta with the previous delta
+ *
+ * Values that increase with a constant step, like timestamps, result in zeros.
+ *
+ * \tparam ValueT  The integral type of the values, differences are computed modulo 2^digits
+ */
+template< std::integral ValueT >
+class delta_of_delta_transform
+{
+    delta_transform< ValueT >                                           value;
+    delta_transform< typename delta_transform< ValueT >::result_type > step;
+
+public:
+    using value_type  = ValueT;
+    using result_type = typename std::make_signed< ValueT >::type;
+
+    /**
+     * \param initial  The value that precedes the first value
+     */
+    constexpr delta_of_delta_transform( ValueT initial = {} )
+        : value( initial )
+        , step()
+    {}
+
+    [[nodiscard]] constexpr result_type forward( value_type x )
+    {
+        return step.forward( value.forward( x ) );
+    }
+
+    [[nodiscard]] constexpr value_type inverse( result_type dd )
+    {
+        return value.inverse( step.inverse( dd ) );
+    }
+};
+
+/**
+ * \brief Transform stage that replaces a value by its bitwise exclusive or with the previous value
+ *
+ * \tparam ValueT  The integral type of the values
+ */
+template< std::integral ValueT >
+class xor_transform
+{
+    using UnsignedValueT = typename std::make_unsigned< ValueT >::type;
+
+    UnsignedValueT previous;
+
+public:
+    using value_type  = ValueT;
+    using result_type = UnsignedValueT;
+
+    /**
+     * \param initial  The value that precedes the first value
+     */
+    constexpr xor_transform( ValueT initial = {} )
+        : previous( static_cast< UnsignedValueT >( initial ) )
+    {}
+
+    [[nodiscard]] constexpr result_type forward( value_type x )
+    {
+        const auto r = static_cast< result_type >( previous ^ static_cast< UnsignedValueT >( x ) );
+        previous     = static_cast< UnsignedValueT >( x );
+
+        return r;
+    }
+
+    [[nodiscard]] constexpr value_type inverse( result_type r )
+    {
+        previous = static_cast< UnsignedValueT >( previous ^ r );
+
+        return static_cast< value_type >( previous );
+    }
+};
+
+/**
+ * \brief Transform stage that replaces a value by its offset from a reference value
+ *
+ * Use the smallest value of the data as reference to get small offsets.
+ *
+ * \tparam ValueT  The integral type of the values, offsets are computed modulo 2^digits
+ */
+template< std::integral ValueT >
+class frame_of_reference_transform
+{
+    using UnsignedValueT = typename std::make_unsigned< ValueT >::type;
+
+    UnsignedValueT reference;
+
+public:
+    using value_type  = ValueT;
+    using result_type = UnsignedValueT;
+
+    /**
+     * \param reference  The value that is subtracted from the values
+     */
+    constexpr frame_of_reference_transform( ValueT reference = {} )
+        : reference( static_cast< UnsignedValueT >( reference ) )
+    {}
+
+    [[nodiscard]] constexpr result_type forward( value_type x ) const
+    {
+        return static_cast< result_type >( static_cast< UnsignedValueT >( x ) - reference );
+    }
+
+    [[nodiscard]] constexpr value_type inverse( result_type r ) const
+    {
+        return static_cast< value_type >( static_cast< UnsignedValueT >( r + reference ) );
+    }
+};
+
+/**
+ * \brief Transform stage that applies two stages after each other
+ *
+ * The result of the first stage is the input of the second stage, pipelines can be nested to combine more stages.
+ *
+ * \tparam FirstT   The stage that is applied first when encoding
+ * \tparam SecondT  The stage that is applied second when encoding
+ */
+template< transform_stage FirstT, transform_stage SecondT >
+requires std::same_as< typename FirstT::result_type, typename SecondT::value_type >
+class transform_pipeline
+{
+    FirstT  first;
+    SecondT second;
+
+public:
+    using value_type  = typename FirstT::value_type;
+    using result_type = typename SecondT::result_type;
+
+    constexpr transform_pipeline( FirstT first = {}, SecondT second = {} )
+        : first( first )
+        , second( second )
+    {}
+
+    [[nodiscard]] constexpr result_type forward( value_type x )
+    {
+        return second.forward( first.forward( x ) );
+    }
+
+    [[nodiscard]] constexpr value_type inverse( result_type r )
+    {
+        return first.inverse( second.inverse( r ) );
+    }
+};
+
+/**
+ * \brief Encoder that applies a transform stage to the values before they are encoded
+ *
+ * Wraps an \em encoder or an adaptive encoder, the values are transformed in the same pass as they are encoded.
+ *
+ * \tparam EncoderT  The type of the wrapped encoder
+ * \tparam StageT    The transform stage, see \em transform_stage
+ */
+template< typename EncoderT, transform_stage StageT >
+class transform_encoder
+{
+    EncoderT e;
+    StageT   stage;
+
+public:
+    using value_type = typename StageT::value_type;
+
+    /**
+     * \brief Construct the transform encoder
+     *
+     * \param encoder  The encoder that encodes the transformed values
+     * \param stage    The transform stage in its initial state
+     */
+    constexpr transform_encoder( EncoderT encoder, StageT stage = {} )
+        : e( encoder )
+        , stage( stage )
+    {}
+
+    /**
+     * \brief Transforms and encodes a value with order \em k
+     */
+    template< size_t k >
+    constexpr auto push( value_type x )
+    {
+        return e.template push< k >( stage.forward( x ) );
+    }
+
+    /**
+     * \brief Transforms and encodes a value, \em k is the order for an \em encoder and is omitted for an adaptive encoder
+     */
+    template< std::integral... OrderT >
+    constexpr auto push( value_type x, OrderT... k )
+    {
+        return e.push( stage.forward( x ), k... );
+    }
+
+    constexpr auto flush()
+    {
+        return e.flush();
+    }
+
+    [[nodiscard]] constexpr size_t size() const
+    {
+        return e.size();
+    }
+};
+
+/**
+ * \brief Decoder that reverses a transform stage on the values it decodes
+ *
+ * Wraps a \em decoder or an adaptive decoder, the values are restored in the same pass as they are decoded.
+ *
+ * \tparam DecoderT  The type of the wrapped decoder
+ * \tparam StageT    The transform stage, in the same initial state as used for encoding
+ */
+template< typename DecoderT, transform_stage StageT >
+class transform_decoder
+{
+    using ResultT = typename StageT::result_type;
+
+    DecoderT d;
+    StageT   stage;
+
+    [[nodiscard]] constexpr decoder_result< typename StageT::value_type > restore( decoder_result< ResultT > result )
+    {
+        if( result.status == decoder_status::success )
+        {
+            return { stage.inverse( result.value ), result.status };
+        }
+
+        return { static_cast< typename StageT::value_type >( result.value ), result.status };
+    }
+
+public:
+    using value_type = typename StageT::value_type;
+
+    /**
+     * \brief Construct the transform decoder
+     *
+     * \param decoder  The decoder that decodes the transformed values
+     * \param stage    The transform stage in its initial state
+     */
+    [[nodiscard]] constexpr transform_decoder( DecoderT decoder, StageT stage = {} )
+        : d( decoder )
+        , stage( stage )
+    {}
+
+    /**
+     * \brief Decodes a value with order \em k and reverses the transform
+     */
+    template< size_t k >
+    [[nodiscard]] constexpr decoder_result< value_type > pull()
+    {
+        return restore( d.template pull< ResultT, k >() );
+    }
+
+    /**
+     * \brief Decodes a value and reverses the transform, \em k is the order for a \em decoder and is omitted for
+     *        an adaptive decoder
+     */
+    template< std::integral... OrderT >
+    [[nodiscard]] constexpr decoder_result< value_type > pull( OrderT... k )
+    {
+        return restore( d.template pull< ResultT >( k... ) );
+    }
+
+    /**
+     * \brief Decodes a value and reverses the transform, with the same template arguments as the pulls of the
+     *        wrapped decoder; the order \em k is omitted for an adaptive decoder
+     */
+    template< std::same_as< value_type > OutputValueT, size_t... k >
+    requires( sizeof...( k ) <= 1u )
+    [[nodiscard]] constexpr decoder_result< value_type > pull()
+    {
+        return restore( d.template pull< ResultT, k... >() );
+    }
+
+    [[nodiscard]] constexpr bool has_data() const
+    {
+        return d.has_data();
+    }
+};
+
+/**
+ * \overload encode( InputIt input, InputIt last, OutputIt output, size_t k = {} )
+ *
+ * \param input  A range to read integral values from that are transformed and encoded
+ * \param output The output iterator to which the ecoded values are written
+ * \param k      The order the transformed values will be encoded
+ * \param stage  The transform stage that is applied to the values, see \em transform_stage
+ */
+template< std::unsigned_integral OutputDataT = uint8_t,
+          detail::integral_input_range InputRangeT,
+          typename OutputIt,
+          transform_stage StageT >
+requires std::output_iterator< OutputIt, OutputDataT > &&
+         std::convertible_to< std::ranges::range_value_t< InputRangeT >, typename StageT::value_type >
+constexpr auto encode( InputRangeT input, OutputIt output, size_t k, StageT stage )
+{
+    transform_encoder e( encoder< OutputIt, OutputDataT >( output ), stage );
+
+    for( const auto& value : input )
+    {
+        e.push( static_cast< typename StageT::value_type >( value ), k );
+    }
+
+    return e.flush();
+}
+
+/**
+ * \overload decode( InputIt input, InputIt last, OutputIt output, size_t k = {} )
+ *
+ * \tparam OutputValueT The integral type of the decoded values, must be the value type of the stage
+ *
+ * \param input  An input range to read binary golomb data from
+ * \param output The output iterator to which the decoded values are written
+ * \param k      The order in which the data from input is encoded
+ * \param stage  The transform stage that is reversed on the values, in the same state as used for encoding
+ */
+template< std::integral OutputValueT,
+          detail::unsigned_integral_input_range InputRangeT,
+          typename OutputIt,
+          transform_stage StageT >
+requires std::output_iterator< OutputIt , OutputValueT > && std::same_as< OutputValueT, typename StageT::value_type >
+constexpr auto decode( InputRangeT input, OutputIt output, size_t k, StageT stage )
+{
+    transform_decoder d( decoder( std::begin( input ), std::end( input ) ), stage );
+
+    while( d.has_data() )
+    {
+        const auto [ value, status ] = d.pull( k );
+        if( status == decoder_status::success )
+        {
+            *output++ = value;
+        }
+    }
+
+    return output;
+}
+
+/**
+ * \brief The filter shift of a \em codec that encodes all values with the same order
+ */
+inline constexpr size_t no_adaptation = dynamic_shift - 1u;
+
+/**
+ * \brief Describes a golomb code of which all parameters are known at compile time
+ *
+ * The encoders and decoders that are made by a codec are specialized for its parameters,
+ * the order is a template argument of every push and pull.
+ *
+ * \tparam ValueT      The integral type of the values that are encoded and decoded
+ * \tparam WordT       The type of the words of the encoded data
+ * \tparam Order       The order of the values, the initial order for an adaptive codec
+ * \tparam Adaptive    Filter shift of the adaptive order, see \em adaptive_encoder, or \em no_adaptation
+ * \tparam TransformT  The transform stage that is applied to the values, see \em transform_stage
+ */
+template< std::integral ValueT,
+          std::unsigned_integral WordT = uint8_t,
+          size_t Order                 = 0u,
+          size_t Adaptive              = no_adaptation,
+          transform_stage TransformT   = identity_transform< ValueT > >
+requires std::same_as< ValueT, typename TransformT::value_type > &&
+         ( Order < static_cast< size_t >( std::numeric_limits< typename std::make_unsigned< ValueT >::type >::digits ) ) &&
+         ( Adaptive != dynamic_shift )
+struct codec
+{
+    using value_type     = ValueT;
+    using word_type      = WordT;
+    using transform_type = TransformT;
+
+    static constexpr size_t order       = Order;
+    static constexpr size_t shift       = Adaptive;
+    static constexpr bool   is_adaptive = Adaptive != no_adaptation;
+
+private:
+    static constexpr bool is_identity = std::same_as< TransformT, identity_transform< ValueT > >;
+
+    template< typename OutputIt >
+    using base_encoder_type = std::conditional_t< is_adaptive,
+                                                  adaptive_encoder< OutputIt, Adaptive, WordT >,
+                                                  encoder< OutputIt, WordT > >;
+
+    template< typename InputIt >
+    using base_decoder_type = std::conditional_t< is_adaptive,
+                                                  adaptive_decoder< InputIt, Adaptive >,
+                                                  decoder< InputIt > >;
+
+public:
+    /**
+     * \brief The type of the encoder that writes to an \em OutputIt, a \em transform_encoder unless the stage is
+     *        the \em identity_transform
+     */
+    template< typename OutputIt >
+    using encoder_type = std::conditional_t< is_identity,
+                                             base_encoder_type< OutputIt >,
+                                             transform_encoder< base_encoder_type< OutputIt >, TransformT > >;
+
+    /**
+     * \brief The type of the decoder that reads from an \em InputIt, a \em transform_decoder unless the stage is
+     *        the \em identity_transform
+     */
+    template< detail::unsigned_integral_input_iterator InputIt >
+    using decoder_type = std::conditional_t< is_identity,
+                                             base_decoder_type< InputIt >,
+                                             transform_decoder< base_decoder_type< InputIt >, TransformT > >;
+
+    /**
+     * \brief Makes an encoder for the codec
+     *
+     * \param output  The output iterator to which the encoded words are written
+     * \param stage   The transform stage in its initial state
+     */
+    template< typename OutputIt >
+    requires std::output_iterator< OutputIt, WordT >
+    [[nodiscard]] static constexpr encoder_type< OutputIt > make_encoder( OutputIt output, TransformT stage = {} )
+    {
+        auto e = [ & ]()
+        {
+            if constexpr( is_adaptive )
+            {
+                return base_encoder_type< OutputIt >( output, Order );
+            }
+            else
+            {
+                return base_encoder_type< OutputIt >( output );
+            }
+        }();
+
+        if constexpr( is_identity )
+        {
+            return e;
+        }
+        else
+        {
+            return encoder_type< OutputIt >( e, stage );
+        }
+    }
+
+    /**
+     * \brief Makes a decoder for the codec
+     *
+     * \param input      Begin iterator of the decoder's input containing encoded golomb data.
+     * \param input_end  End iterator that marks the end of the input data.
+     * \param stage      The transform stage in the same initial state as used for encoding
+     */
+    template< detail::unsigned_integral_input_iterator InputIt >
+    [[nodiscard]] static constexpr decoder_type< InputIt > make_decoder( InputIt input, InputIt input_end, TransformT stage = {} )
+    {
+        auto d = [ & ]()
+        {
+            if constexpr( is_adaptive )
+            {
+                return base_decoder_type< InputIt >( input, input_end, Order );
+            }
+            else
+            {
+                return base_decoder_type< InputIt >( input, input_end );
+            }
+        }();
+
+        if constexpr( is_identity )
+        {
+            return d;
+        }
+        else
+        {
+            return decoder_type< InputIt >( d, stage );
+        }
+    }
+
+    /**
+     * \brief Encodes a value with an encoder of the codec
+     *
+     * \param e  An encoder made by \em make_encoder, which may be wrapped in a \em stats_encoder
+     * \param x  The value that is encoded
+     */
+    template< typename EncoderT >
+    static constexpr auto push( EncoderT & e, value_type x )
+    {
+        if constexpr( is_adaptive )
+        {
+            return e.push( x );
+        }
+        else
+        {
+            return e.template push< Order >( x );
+        }
+    }
+
+    /**
+     * \brief Decodes a value with a decoder of the codec
+     *
+     * \param d  A decoder made by \em make_decoder, which may be wrapped in a \em stats_decoder
+     *
+     * \return A \em decoder_result struct containing the decoded value and/or decoder status
+     */
+    template< typename DecoderT >
+    [[nodiscard]] static constexpr decoder_result< value_type > pull( DecoderT & d )
+    {
+        if constexpr( is_adaptive )
+        {
+            return d.template pull< value_type >();
+        }
+        else
+        {
+            return d.template pull< value_type, Order >();
+        }
+    }
+
+    /**
+     * \brief Decodes values with a decoder of the codec until \em output is filled or decoding did not succeed
+     *
+     * \param d       A decoder made by \em make_decoder, which may be wrapped in a \em stats_decoder
+     * \param output  The span to which the decoded values are written
+     *
+     * \return A \em decoder_batch_result struct containing the number of values written to output and the status
+     *         of the last pull. The status is \em success when \em output is filled.
+     */
+    template< typename DecoderT >
+    [[nodiscard]] static constexpr decoder_batch_result pull_n( DecoderT & d, std::span< value_type > output )
+    {
+        if constexpr( !is_adaptive && requires { d.template pull_n< value_type, Order >( output ); } )
+        {
+            return d.template pull_n< value_type, Order >( output );
+        }
+        else if constexpr( is_adaptive && requires { d.template pull_n< value_type >( output ); } )
+        {
+            return d.template pull_n< value_type >( output );
+        }
+        else
+        {
+            size_t count = {};
+            for( ; count < output.size() ; ++count )
+            {
+                const auto [ value, status ] = pull( d );
+                if( status != decoder_status::success )
+                {
+                    return { count, status };
+                }
+
+                output[ count ] = value;
+            }
+
+            return { count, decoder_status::success };
+        }
+    }
+
+    /**
+     * \brief Encodes the values of a range
+     *
+     * \param input   A range to read integral values from
+     * \param output  The output iterator to which the encoded words are written
+     * \param stage   The transform stage in its initial state
+     *
+     * \return The output iterator that points to the word after the last written word
+     */
+    template< detail::integral_input_range InputRangeT, typename OutputIt >
+    requires std::output_iterator< OutputIt, WordT >
+    static constexpr OutputIt encode( const InputRangeT & input, OutputIt output, TransformT stage = {} )
+    {
+        auto e = make_encoder( output, stage );
+
+        for( const auto & value : input )
+        {
+            push( e, static_cast< value_type >( value ) );
+        }
+
+        return e.flush();
+    }
+
+    /**
+     * \brief Decodes the values of a range with encoded data
+     *
+     * \param input   An input range to read binary golomb data from
+     * \param output  The output iterator to which the decoded values are written
+     * \param stage   The transform stage in the same initial state as used for encoding
+     *
+     * \return The output iterator that points to the value after the last written value
+     */
+    template< detail::unsigned_integral_input_range InputRangeT, typename OutputIt >
+    requires std::output_iterator< OutputIt, value_type >
+    static constexpr OutputIt decode( const InputRangeT & input, OutputIt output, TransformT stage = {} )
+    {
+        auto d = make_decoder( std::begin( input ), std::end( input ), stage );
+
+        while( d.has_data() )
+        {
+            const auto [ value, status ] = pull( d );
+            if( status == decoder_status::success )
+            {
+                *output++ = value;
+            }
+        }
+
+        return output;
+    }
+
+    /**
+     * \brief Decodes values from a range with encoded data until \em output is filled or the input is exhausted
+     *
+     * \param input   An input range to read binary golomb data from
+     * \param output  The span to which the decoded values are written
+     * \param stage   The transform stage in the same initial state as used for encoding
+     *
+     * \return A \em decoder_batch_result struct containing the number of values written to output.
+     *         The status is \em success when output is filled or \em done when all the input is decoded.
+     */
+    template< detail::unsigned_integral_input_range InputRangeT >
+    [[nodiscard]] static constexpr decoder_batch_result decode_into( const InputRangeT & input,
+                                                                     std::span< value_type > output,
+                                                                     TransformT stage = {} )
+    {
+        auto d = make_decoder( std::begin( input ), std::end( input ), stage );
+
+        size_t count = {};
+        while( true )
+        {
+            const auto [ n, status ] = pull_n( d, output.subspan( count ) );
+
+            count += n;
+            if( status != decoder_status::zero_overflow )
+            {
+                return { count, status };
+            }
+        }
+    }
+};
+
+/**
+ * \brief Statistics of the codewords that are encoded by a \em stats_encoder or decoded by a \em stats_decoder
+ */
+struct codec_stats
+{
+    size_t                    values         = {};  ///< Number of encoded or decoded values
+    size_t                    bits           = {};  ///< Total number of bits of the codewords
+    size_t                    flushes        = {};  ///< Number of flushes of the encoder
+    size_t                    zero_overflows = {};  ///< Number of pulls that returned \em zero_overflow
+    size_t                    order_changes  = {};  ///< Number of times the order of an adaptive encoder or decoder changed
+    std::array< size_t, 65 >  zeros          = {};  ///< Number of codewords per number of prefix zeros
+
+    /**
+     * \brief Counts the codeword of value \em x encoded with order \em k
+     */
+    template< std::integral ValueT >
+    constexpr void count( ValueT x, size_t k )
+    {
+        using UnsignedValueT = typename std::make_unsigned< ValueT >::type;
+
+        k = std::min( k, static_cast< size_t >( std::numeric_limits< UnsignedValueT >::digits - 1 ) );
+
+        const auto length = encoded_bits( x, k );
+
+        ++values;
+        bits += length;
+        ++zeros[ ( length - k - 1u ) / 2u ];
+    }
+
+    /**
+     * \brief Adds the statistics of \em other, for example of a block that is encoded in another thread
+     */
+    constexpr codec_stats & operator+=( const codec_stats & other )
+    {
+        values         += other.values;
+        bits           += other.bits;
+        flushes        += other.flushes;
+        zero_overflows += other.zero_overflows;
+        order_changes  += other.order_changes;
+        for( size_t i = 0u ; i < zeros.size() ; ++i )
+        {
+            zeros[ i ] += other.zeros[ i ];
+        }
+
+        return *this;
+    }
+};
+
+/**
+ * \brief Encoder that collects statistics of the values it encodes
+ *
+ * Wraps an \em encoder or an adaptive encoder, see also \em codec_stats.
+ * The statistics cost nothing when the wrapper is not used.
+ *
+ * \tparam EncoderT  The type of the wrapped encoder
+ */
+template< typename EncoderT >
+class stats_encoder
+{
+    EncoderT    e;
+    codec_stats s;
+
+public:
+    /**
+     * \brief Construct the stats encoder
+     *
+     * \param encoder  The encoder that encodes the values
+     */
+    constexpr stats_encoder( EncoderT encoder )
+        : e( encoder )
+    {}
+
+    /**
+     * \brief Encodes a value with order \em k
+     */
+    template< size_t k, std::integral InputValueT >
+    constexpr auto push( InputValueT x )
+    {
+        s.count( x, k );
+
+        return e.template push< k >( x );
+    }
+
+    /**
+     * \brief Encodes a value with order \em k for an \em encoder
+     */
+    template< std::integral InputValueT >
+    constexpr auto push( InputValueT x, size_t k )
+    {
+        s.count( x, k );
+
+        return e.push( x, k );
+    }
+
+    /**
+     * \brief Encodes a value with the order of an adaptive encoder
+     */
+    template< std::integral InputValueT >
+    constexpr auto push( InputValueT x )
+    {
+        const auto k = e.order();
+
+        s.count( x, k );
+
+        const auto output = e.push( x );
+
+        s.order_changes += e.order() != k;
+
+        return output;
+    }
+
+    constexpr auto flush()
+    {
+        ++s.flushes;
+
+        return e.flush();
+    }
+
+    [[nodiscard]] constexpr size_t size() const
+    {
+        return e.size();
+    }
+
+    /**
+     * \brief Returns the statistics of the values that are encoded
+     */
+    [[nodiscard]] constexpr const codec_stats & stats() const
+    {
+        return s;
+    }
+};
+
+/**
+ * \brief Decoder that collects statistics of the values it decodes
+ *
+ * Wraps a \em decoder or an adaptive decoder, see also \em codec_stats.
+ * The statistics cost nothing when the wrapper is not used.
+ *
+ * \tparam DecoderT  The type of the wrapped decoder
+ */
+template< typename DecoderT >
+class stats_decoder
+{
+    DecoderT    d;
+    codec_stats s;
+
+    template< std::integral OutputValueT >
+    constexpr decoder_result< OutputValueT > count( decoder_result< OutputValueT > result, size_t k )
+    {
+        if( result.status == decoder_status::success )
+        {
+            s.count( result.value, k );
+        }
+        else if( result.status == decoder_status::zero_overflow )
+        {
+            ++s.zero_overflows;
+        }
+
+        return result;
+    }
+
+public:
+    /**
+     * \brief Construct the stats decoder
+     *
+     * \param decoder  The decoder that decodes the values
+     */
+    [[nodiscard]] constexpr stats_decoder( DecoderT decoder )
+        : d( decoder )
+    {}
+
+    /**
+     * \brief Decodes a value with order \em k, or with the order of an adaptive decoder
+     */
+    template< std::integral OutputValueT, size_t k = {} >
+    [[nodiscard]] constexpr decoder_result< OutputValueT > pull()
+    {
+        if constexpr( requires { d.order(); } )
+        {
+            const auto order  = d.order();
+            const auto result = count( d.template pull< OutputValueT >(), order );
+
+            s.order_changes += d.order() != order;
+
+            return result;
+        }
+        else
+        {
+            return count( d.template pull< OutputValueT, k >(), k );
+        }
+    }
+
+    /**
+     * \brief Decodes values until \em output is filled or decoding did not succeed, see \em decoder::pull_n
+     *
+     * \param output  The span to which the decoded values are written
+     * \param k       The order for a \em decoder, is omitted for an adaptive decoder
+     */
+    template< std::integral OutputValueT, std::integral... OrderT >
+    [[nodiscard]] constexpr decoder_batch_result pull_n( std::span< OutputValueT > output, OrderT... k )
+    {
+        size_t count = {};
+        for( ; count < output.size() ; ++count )
+        {
+            const auto [ value, status ] = pull< OutputValueT >( k... );
+            if( status != decoder_status::success )
+            {
+                return { count, status };
+            }
+
+            output[ count ] = value;
+        }
+
+        return { count, decoder_status::success };
+    }
+
+    /**
+     * \brief Decodes a value with order \em k for a \em decoder
+     */
+    template< std::integral OutputValueT >
+    [[nodiscard]] constexpr decoder_result< OutputValueT > pull( size_t k )
+    {
+        return count( d.template pull< OutputValueT >( k ), k );
+    }
+
+    [[nodiscard]] constexpr bool has_data() const
+    {
+        return d.has_data();
+    }
+
+    /**
+     * \brief Returns the statistics of the values that are decoded
+     */
+    [[nodiscard]] constexpr const codec_stats & stats() const
+    {
+        return s;
+    }
+};
+
+/**
+ * \brief Index entry of a block of encoded values that can be decoded independently of the other blocks
+ */
+struct block_info
+{
+    size_t value_offset;    ///< Position of the block's first value in the original data
+    size_t data_offset;     ///< Position of the block's first word in the encoded data
+    size_t k;               ///< Order with which the block's first value is encoded, for adaptive blocks the state of the \em ema_policy
+};
+
+/**
+ * \brief Encodes integral values from an input with a specified golomb order in independently decodable blocks
+ *
+ * Each block starts at a new \em OutputDataT word in the output and is registered with a \em block_info entry in
+ * the index. The index can be used with \em decode_blocks to decode values at random positions without decoding
+ * the data that precedes their block.
+ *
+ * \param input       An input iterator to read integral values from
+ * \param last        The iterator that marks the end of input range
+ * \param output      The output iterator to which the ecoded values are written
+ * \param index       The output iterator to which a \em block_info is written for each block
+ * \param block_size  The number of values per block, must be larger than 0
+ * \param k           The order the values from input will be encoded
+ *
+ * \return A pair with the output iterator and the index iterator one past the data that has been written to them
+ */
+template< std::unsigned_integral OutputDataT = uint8_t,
+          detail::integral_input_iterator InputIt,
+          typename OutputIt,
+          typename IndexIt >
+requires std::output_iterator< OutputIt, OutputDataT > && std::output_iterator< IndexIt, block_info >
+constexpr auto encode_blocks( InputIt input, InputIt last, OutputIt output, IndexIt index, size_t block_size, size_t k = {} )
+{
+    using ValueT = typename std::iterator_traits< InputIt >::value_type;
+
+    encoder< OutputIt, OutputDataT > e( output );
+
+    for( size_t position = {} ; input != last ; ++position )
+    {
+        if( position % block_size == 0u )
+        {
+            e.flush();
+            *index++ = block_info{ position, e.size(), k };
+        }
+
+        e.push( static_cast< ValueT >( *input++ ), k );
+    }
+
+    return std::pair{ e.flush(), index };
+}
+
+/**
+ * \overload encode_blocks( InputIt input, InputIt last, OutputIt output, IndexIt index, size_t block_size, size_t k = {} )
+ *
+ * \param input       A range to read integral values from that are encoded
+ * \param output      The output iterator to which the ecoded values are written
+ * \param index       The output iterator to which a \em block_info is written for each block
+ * \param block_size  The number of values per block, must be larger than 0
+ * \param k           The order the values from input will be encoded
+ */
+template< std::unsigned_integral OutputDataT = uint8_t,
+          detail::integral_input_range InputRangeT,
+          typename OutputIt,
+          typename IndexIt >
+requires std::output_iterator< OutputIt, OutputDataT > && std::output_iterator< IndexIt, block_info >
+constexpr auto encode_blocks( InputRangeT input, OutputIt output, IndexIt index, size_t block_size, size_t k = {} )
+{
+    return encode_blocks< OutputDataT >( std::begin( input ), std::end( input ), output, index, block_size, k );
+}
+
+/**
+ * \brief Encodes integral values in independently decodable blocks with the optimal order for each block
+ *
+ * Like \em encode_blocks but each block is encoded with the order returned by \em optimal_order for the values
+ * in the block. The order is stored in the block's \em block_info entry, which makes the data decodable with
+ * \em decode_blocks. The values of each block are read twice.
+ *
+ * \param input       A forward iterator to read integral values from
+ * \param last        The iterator that marks the end of input range
+ * \param output      The output iterator to which the ecoded values are written
+ * \param index       The output iterator to which a \em block_info is written for each block
+ * \param block_size  The number of values per block, must be larger than 0
+ *
+ * \return A pair with the output iterator and the index iterator one past the data that has been written to them
+ */
+template< std::unsigned_integral OutputDataT = uint8_t,
+          detail::integral_input_iterator InputIt,
+          typename OutputIt,
+          typename IndexIt >
+requires std::forward_iterator< InputIt > &&
+         std::output_iterator< OutputIt, OutputDataT > && std::output_iterator< IndexIt, block_info >
+constexpr auto encode_optimal_blocks( InputIt input, InputIt last, OutputIt output, IndexIt index, size_t block_size )
+{
+    using ValueT = typename std::iterator_traits< InputIt >::value_type;
+
+    encoder< OutputIt, OutputDataT > e( output );
+
+    for( size_t position = {} ; input != last ; )
+    {
+        using DifferenceT = typename std::iterator_traits< InputIt >::difference_type;
+
+        const auto block_last = std::ranges::next( input, static_cast< DifferenceT >( block_size ), last );
+        const auto k          = optimal_order( input, block_last );
+
+        e.flush();
+        *index++ = block_info{ position, e.size(), k };
+
+        for( ; input != block_last ; ++input, ++position )
+        {
+            e.push( static_cast< ValueT >( *input ), k );
+        }
+    }
+
+    return std::pair{ e.flush(), index };
+}
+
+/**
+ * \overload encode_optimal_blocks( InputIt input, InputIt last, OutputIt output, IndexIt index, size_t block_size )
+ *
+ * \param input       A forward range to read integral values from that are encoded
+ * \param output      The output iterator to which the ecoded values are written
+ * \param index       The output iterator to which a \em block_info is written for each block
+ * \param block_size  The number of values per block, must be larger than 0
+ */
+template< std::unsigned_integral OutputDataT = uint8_t,
+          detail::integral_input_range InputRangeT,
+          typename OutputIt,
+          typename IndexIt >
+requires std::ranges::forward_range< InputRangeT > &&
+         std::output_iterator< OutputIt, OutputDataT > && std::output_iterator< IndexIt, block_info >
+constexpr auto encode_optimal_blocks( const InputRangeT & input, OutputIt output, IndexIt index, size_t block_size )
+{
+    return encode_optimal_blocks< OutputDataT >( std::ranges::begin( input ), std::ranges::end( input ), output, index, block_size );
+}
+
+/**
+ * \brief Decodes a number of values at a given position from golomb data that is encoded in blocks
+ *
+ * Only the blocks that contain the requested values are decoded.
+ *
+ * \tparam OutputValueT The integral type of the decoded values
+ *
+ * \param input   The random access iterator to the begin of the golomb data
+ * \param last    The iterator that marks the end of the golomb data
+ * \param index   The block index of the golomb data, as created by \em encode_blocks
+ * \param first   Position of the first value to decode
+ * \param count   The number of values to decode
+ * \param output  The output iterator to which the decoded values are written
+ *
+ * \note The golomb data must be decoded with the same data type as it is encoded in.
+ *
+ * \return The output iterator one past the last decoded value
+ */
+template< std::integral OutputValueT,
+          std::random_access_iterator InputIt,
+          std::ranges::random_access_range IndexRangeT,
+          typename OutputIt >
+requires std::unsigned_integral< typename std::iterator_traits< InputIt >::value_type > &&
+         std::same_as< std::ranges::range_value_t< IndexRangeT >, block_info > &&
+         std::output_iterator< OutputIt, OutputValueT >
+constexpr auto decode_blocks( InputIt input, InputIt last, const IndexRangeT& index,
+                              size_t first, size_t count, OutputIt output )
+{
+    const auto index_end = std::ranges::end( index );
+
+    auto block = std::ranges::upper_bound( index, first, {}, &block_info::value_offset );
+    if( block == std::ranges::begin( index ) )
+    {
+        return output;
+    }
+
+    for( --block ; count && block != index_end ; ++block )
+    {
+        const auto next       = std::next( block );
+        const auto block_last = next == index_end ? last : input + next->data_offset;
+
+        decoder d( input + block->data_offset, block_last );
+
+        for( auto position = block->value_offset ; count && d.has_data() ; )
+        {
+            const auto [ value, status ] = d.template pull< OutputValueT >( block->k );
+            if( status == decoder_status::success )
+            {
+                if( position++ >= first )
+                {
+                    *output++ = value;
+                    --count;
+                }
+            }
+        }
+    }
+
+    return output;
+}
+
+/**
+ * \overload decode_blocks( InputIt input, InputIt last, const IndexRangeT& index, size_t first, size_t count, OutputIt output )
+ *
+ * \tparam OutputValueT The integral type of the decoded values
+ *
+ * \param input   A random access range with the golomb data
+ * \param index   The block index of the golomb data, as created by \em encode_blocks
+ * \param first   Position of the first value to decode
+ * \param count   The number of values to decode
+ * \param output  The output iterator to which the decoded values are written
+ */
+template< std::integral OutputValueT,
+          std::ranges::random_access_range InputRangeT,
+          std::ranges::random_access_range IndexRangeT,
+          typename OutputIt >
+requires std::unsigned_integral< std::ranges::range_value_t< InputRangeT > > &&
+         std::same_as< std::ranges::range_value_t< IndexRangeT >, block_info > &&
+         std::output_iterator< OutputIt, OutputValueT >
+constexpr auto decode_blocks( const InputRangeT& input, const IndexRangeT& index,
+                              size_t first, size_t count, OutputIt output )
+{
+    return decode_blocks< OutputValueT >( std::ranges::begin( input ), std::ranges::end( input ), index,
+                                          first, count, output );
+}
+
+/**
+ * \brief Encodes integral values in independently decodable blocks while adapting the order to the encoded values
+ *
+ * The order adapts over the whole input like \em adaptive_encode, it is not reset at the start of a block. The
+ * state of the \em ema_policy is its order, which is stored in the block's \em block_info entry so that
+ * \em adaptive_decode_blocks can resume the adaptation at any block. Policies with more state than their order,
+ * like \em attack_decay_policy, can not be restored from the index and are not supported.
+ *
+ * \tparam Shift  Filter shift of the adaptive order, see \em adaptive_encoder
+ *
+ * \param input       An input iterator to read integral values from
+ * \param last        The iterator that marks the end of input range
+ * \param output      The output iterator to which the ecoded values are written
+ * \param index       The output iterator to which a \em block_info is written for each block
+ * \param block_size  The number of values per block, must be larger than 0
+ * \param k           The initial order
+ *
+ * \return A pair with the output iterator and the index iterator one past the data that has been written to them
+ */
+template< size_t Shift,
+          std::unsigned_integral OutputDataT = uint8_t,
+          detail::integral_input_iterator InputIt,
+          typename OutputIt,
+          typename IndexIt >
+requires std::output_iterator< OutputIt, OutputDataT > && std::output_iterator< IndexIt, block_info > &&
+         ( Shift != dynamic_shift )
+constexpr auto adaptive_encode_blocks( InputIt input, InputIt last, OutputIt output, IndexIt index,
+                                       size_t block_size, size_t k = {} )
+{
+    using ValueT = typename std::iterator_traits< InputIt >::value_type;
+
+    adaptive_encoder< OutputIt, Shift, OutputDataT > e( output, k );
+
+    for( size_t position = {} ; input != last ; ++position )
+    {
+        if( position % block_size == 0u )
+        {
+            e.flush();
+            *index++ = block_info{ position, e.size(), e.order() };
+        }
+
+        e.push( static_cast< ValueT >( *input++ ) );
+    }
+
+    return std::pair{ e.flush(), index };
+}
+
+/**
+ * \overload adaptive_encode_blocks( InputIt input, InputIt last, OutputIt output, IndexIt index, size_t block_size, size_t k = {} )
+ *
+ * \param input       A range to read integral values from that are encoded
+ * \param output      The output iterator to which the ecoded values are written
+ * \param index       The output iterator to which a \em block_info is written for each block
+ * \param block_size  The number of values per block, must be larger than 0
+ * \param k           The initial order
+ */
+template< size_t Shift,
+          std::unsigned_integral OutputDataT = uint8_t,
+          detail::integral_input_range InputRangeT,
+          typename OutputIt,
+          typename IndexIt >
+requires std::output_iterator< OutputIt, OutputDataT > && std::output_iterator< IndexIt, block_info > &&
+         ( Shift != dynamic_shift )
+constexpr auto adaptive_encode_blocks( InputRangeT input, OutputIt output, IndexIt index, size_t block_size, size_t k = {} )
+{
+    return adaptive_encode_blocks< Shift, OutputDataT >( std::begin( input ), std::end( input ), output, index,
+                                                         block_size, k );
+}
+
+/**
+ * \brief Decodes a number of values at a given position from golomb data that is encoded in adaptive blocks
+ *
+ * Only the blocks that contain the requested values are decoded. The adaptation of the order is resumed at the
+ * first of these blocks with the order from its \em block_info entry.
+ *
+ * \tparam OutputValueT The integral type of the decoded values
+ * \tparam Shift        Filter shift of the adaptive order, must be the same as the one the data is encoded with
+ *
+ * \param input   The random access iterator to the begin of the golomb data
+ * \param last    The iterator that marks the end of the golomb data
+ * \param index   The block index of the golomb data, as created by \em adaptive_encode_blocks
+ * \param first   Position of the first value to decode
+ * \param count   The number of values to decode
+ * \param output  The output iterator to which the decoded values are written
+ *
+ * \note The golomb data must be decoded with the same data type as it is encoded in.
+ *
+ * \return The output iterator one past the last decoded value
+ */
+template< std::integral OutputValueT,
+          size_t Shift,
+          std::random_access_iterator InputIt,
+          std::ranges::random_access_range IndexRangeT,
+          typename OutputIt >
+requires std::unsigned_integral< typename std::iterator_traits< InputIt >::value_type > &&
+         std::same_as< std::ranges::range_value_t< IndexRangeT >, block_info > &&
+         std::output_iterator< OutputIt, OutputValueT > && ( Shift != dynamic_shift )
+constexpr auto adaptive_decode_blocks( InputIt input, InputIt last, const IndexRangeT& index,
+                                       size_t first, size_t count, OutputIt output )
+{
+    const auto index_end = std::ranges::end( index );
+
+    auto block = std::ranges::upper_bound( index, first, {}, &block_info::value_offset );
+    if( block == std::ranges::begin( index ) )
+    {
+        return output;
+    }
+
+    for( --block ; count && block != index_end ; ++block )
+    {
+        const auto next       = std::next( block );
+        const auto block_last = next == index_end ? last : input + next->data_offset;
+
+        adaptive_decoder< InputIt, Shift > d( input + block->data_offset, block_last, block->k );
+
+        for( auto position = block->value_offset ; count && d.has_data() ; )
+        {
+            const auto [ value, status ] = d.template pull< OutputValueT >();
+            if( status == decoder_status::success )
+            {
+                if( position++ >= first )
+                {
+                    *output++ = value;
+                    --count;
+                }
+            }
+        }
+    }
+
+    return output;
+}
+
+/**
+ * \overload adaptive_decode_blocks( InputIt input, InputIt last, const IndexRangeT& index, size_t first, size_t count, OutputIt output )
+ *
+ * \tparam OutputValueT The integral type of the decoded values
+ * \tparam Shift        Filter shift of the adaptive order, must be the same as the one the data is encoded with
+ *
+ * \param input   A random access range with the golomb data
+ * \param index   The block index of the golomb data, as created by \em adaptive_encode_blocks
+ * \param first   Position of the first value to decode
+ * \param count   The number of values to decode
+ * \param output  The output iterator to which the decoded values are written
+ */
+template< std::integral OutputValueT,
+          size_t Shift,
+          std::ranges::random_access_range InputRangeT,
+          std::ranges::random_access_range IndexRangeT,
+          typename OutputIt >
+requires std::unsigned_integral< std::ranges::range_value_t< InputRangeT > > &&
+         std::same_as< std::ranges::range_value_t< IndexRangeT >, block_info > &&
+         std::output_iterator< OutputIt, OutputValueT > && ( Shift != dynamic_shift )
+constexpr auto adaptive_decode_blocks( const InputRangeT& input, const IndexRangeT& index,
+                                       size_t first, size_t count, OutputIt output )
+{
+    return adaptive_decode_blocks< OutputValueT, Shift >( std::ranges::begin( input ), std::ranges::end( input ), index,
+                                                          first, count, output );
+}
+
 }
@@ -0,0 +1,403 @@
+// MIT License
+//
+// Copyright (c) 2022 PG1003
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "golomb.h"
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <array>
+#include <cstring>
+
+#if defined( __x86_64__ ) && defined( __GNUC__ )
+#include <nmmintrin.h>
+#elif defined( __aarch64__ ) && defined( __ARM_FEATURE_CRC32 )
+#include <arm_acle.h>
+#endif
+
+
+namespace pg::golomb
+{
+
+namespace detail
+{
+
+// Tables of the reflected CRC32C polynomial to process 8 bytes per step; table 'n' holds the CRC of a byte
+// that is followed by 'n' zero bytes.
+inline constexpr auto crc32c_tables = []()
+{
+    std::array< std::array< uint32_t, 256 >, 8 > tables = {};
+
+    for( uint32_t byte = 0u ; byte < 256u ; ++byte )
+    {
+        uint32_t crc = byte;
+        for( int bit = 0 ; bit < 8 ; ++bit )
+        {
+            crc = ( crc >> 1 ) ^ ( ( crc & 1u ) ? 0x82F63B78u : 0u );
+        }
+
+        tables[ 0 ][ byte ] = crc;
+    }
+
+    for( size_t n = 1u ; n < tables.size() ; ++n )
+    {
+        for( size_t byte = 0u ; byte < 256u ; ++byte )
+        {
+            const auto previous = tables[ n - 1u ][ byte ];
+
+            tables[ n ][ byte ] = ( previous >> 8 ) ^ tables[ 0 ][ previous & 0xFFu ];
+        }
+    }
+
+    return tables;
+}();
+
+// Continues the inverted CRC 'crc' with the bytes of 'data'.
+[[nodiscard]] inline uint32_t crc32c_software( std::span< const std::byte > data, uint32_t crc ) noexcept
+{
+    const auto & t = crc32c_tables;
+
+    for( ; data.size() >= 8u ; data = data.subspan( 8u ) )
+    {
+        uint64_t word;
+        std::memcpy( &word, data.data(), sizeof( word ) );
+
+        word = fix_endian< std::endian::little >( word ) ^ crc;
+        crc  = t[ 7 ][   word         & 0xFFu ] ^ t[ 6 ][ ( word >>  8 ) & 0xFFu ] ^
+               t[ 5 ][ ( word >> 16 ) & 0xFFu ] ^ t[ 4 ][ ( word >> 24 ) & 0xFFu ] ^
+               t[ 3 ][ ( word >> 32 ) & 0xFFu ] ^ t[ 2 ][ ( word >> 40 ) & 0xFFu ] ^
+               t[ 1 ][ ( word >> 48 ) & 0xFFu ] ^ t[ 0 ][   word >> 56          ];
+    }
+
+    for( const auto byte : data )
+    {
+        crc = ( crc >> 8 ) ^ t[ 0 ][ ( crc ^ static_cast< uint32_t >( byte ) ) & 0xFFu ];
+    }
+
+    return crc;
+}
+
+#if defined( __x86_64__ ) && defined( __GNUC__ )
+// The number of bytes of each of the three parts of data of which the CRCs are calculated at the same time.
+inline constexpr size_t crc32c_lane_size = 4096u;
+
+// Tables that move a CRC over 'crc32c_lane_size' zero bytes, one per byte of the CRC, so that the CRCs of
+// the parts can be combined into the CRC of the whole.
+inline constexpr auto crc32c_shift_tables = []()
+{
+    using operator_t = std::array< uint32_t, 32 >;  // The image of each bit of a CRC
+
+    const auto apply = []( const operator_t & op, uint32_t crc )
+    {
+        uint32_t result = {};
+        for( int bit = 0 ; crc ; ++bit, crc >>= 1 )
+        {
+            result ^= ( crc & 1u ) ? op[ bit ] : 0u;
+        }
+
+        return result;
+    };
+
+    // A single zero byte, then squared until the operator moves over the whole lane
+    operator_t op = {};
+    for( int bit = 0 ; bit < 32 ; ++bit )
+    {
+        const auto crc = uint32_t{ 1u } << bit;
+
+        op[ bit ] = ( crc >> 8 ) ^ crc32c_tables[ 0 ][ crc & 0xFFu ];
+    }
+
+    for( size_t bytes = 1u ; bytes < crc32c_lane_size ; bytes *= 2u )
+    {
+        operator_t squared = {};
+        for( int bit = 0 ; bit < 32 ; ++bit )
+        {
+            squared[ bit ] = apply( op, op[ bit ] );
+        }
+
+        op = squared;
+    }
+
+    std::array< std::array< uint32_t, 256 >, 4 > tables = {};
+    for( size_t n = 0u ; n < tables.size() ; ++n )
+    {
+        for( uint32_t byte = 0u ; byte < 256u ; ++byte )
+        {
+            tables[ n ][ byte ] = apply( op, byte << ( 8u * n ) );
+        }
+    }
+
+    return tables;
+}();
+
+[[nodiscard]] inline uint32_t crc32c_shift( uint32_t crc ) noexcept
+{
+    const auto & t = crc32c_shift_tables;
+
+    return t[ 0 ][ crc & 0xFFu ] ^ t[ 1 ][ ( crc >> 8 ) & 0xFFu ] ^ t[ 2 ][ ( crc >> 16 ) & 0xFFu ] ^ t[ 3 ][ crc >> 24 ];
+}
+
+// Continues the inverted CRC 'crc' with the bytes of 'data' using the crc32 instruction of SSE 4.2.
+// The instruction has a latency of three cycles, so three parts of the data are processed at the same time.
+__attribute__(( target( "sse4.2" ) ))
+[[nodiscard]] inline uint32_t crc32c_hardware( std::span< const std::byte > data, uint32_t crc ) noexcept
+{
+    uint64_t crc64 = crc;
+    for( ; data.size() >= 3u * crc32c_lane_size ; data = data.subspan( 3u * crc32c_lane_size ) )
+    {
+        const auto a = data.data();
+        const auto b = a + crc32c_lane_size;
+        const auto c = b + crc32c_lane_size;
+
+        uint64_t crc_b = {};
+        uint64_t crc_c = {};
+        for( size_t i = 0u ; i < crc32c_lane_size ; i += 8u )
+        {
+            uint64_t words[ 3 ];
+            std::memcpy( &words[ 0 ], a + i, 8u );
+            std::memcpy( &words[ 1 ], b + i, 8u );
+            std::memcpy( &words[ 2 ], c + i, 8u );
+
+            crc64 = _mm_crc32_u64( crc64, words[ 0 ] );
+            crc_b = _mm_crc32_u64( crc_b, words[ 1 ] );
+            crc_c = _mm_crc32_u64( crc_c, words[ 2 ] );
+        }
+
+        const auto ab = crc32c_shift( static_cast< uint32_t >( crc64 ) ) ^ static_cast< uint32_t >( crc_b );
+
+        crc64 = crc32c_shift( ab ) ^ static_cast< uint32_t >( crc_c );
+    }
+
+    for( ; data.size() >= 8u ; data = data.subspan( 8u ) )
+    {
+        uint64_t word;
+        std::memcpy( &word, data.data(), sizeof( word ) );
+
+        crc64 = _mm_crc32_u64( crc64, word );
+    }
+
+    crc = static_cast< uint32_t >( crc64 );
+    for( const auto byte : data )
+    {
+        crc = _mm_crc32_u8( crc, static_cast< uint8_t >( byte ) );
+    }
+
+    return crc;
+}
+#elif defined( __aarch64__ ) && defined( __ARM_FEATURE_CRC32 )
+// Continues the inverted CRC 'crc' with the bytes of 'data' using the crc32c instructions of ARMv8.
+[[nodiscard]] inline uint32_t crc32c_hardware( std::span< const std::byte > data, uint32_t crc ) noexcept
+{
+    for( ; data.size() >= 8u ; data = data.subspan( 8u ) )
+    {
+        uint64_t word;
+        std::memcpy( &word, data.data(), sizeof( word ) );
+
+        crc = __crc32cd( crc, word );
+    }
+
+    for( const auto byte : data )
+    {
+        crc = __crc32cb( crc, static_cast< uint8_t >( byte ) );
+    }
+
+    return crc;
+}
+#endif
+
+// Stores 'n' bytes of 'value' in big endian byte order.
+inline void store_bytes( uint8_t * data, uint64_t value, int n ) noexcept
+{
+    for( int i = 0 ; i < n ; ++i )
+    {
+        data[ i ] = static_cast< uint8_t >( value >> ( 8 * ( n - 1 - i ) ) );
+    }
+}
+
+// Loads 'n' bytes in big endian byte order.
+[[nodiscard]] inline uint64_t load_bytes( const uint8_t * data, int n ) noexcept
+{
+    uint64_t value = {};
+    for( int i = 0 ; i < n ; ++i )
+    {
+        value = ( value << 8 ) | data[ i ];
+    }
+
+    return value;
+}
+
+}
+
+/**
+ * \brief Returns the CRC32C (Castagnoli) checksum of data
+ *
+ * The crc32 instruction is used on x86-64 CPUs with SSE 4.2 and on ARMv8 CPUs with the CRC extension,
+ * otherwise the checksum is calculated with tables.
+ *
+ * \param data  The bytes of the data, e.g. \em std::as_bytes of a span with encoded data
+ * \param crc   The checksum of the preceding data when the checksum is calculated in parts
+ */
+[[nodiscard]] inline uint32_t crc32c( std::span< const std::byte > data, uint32_t crc = {} ) noexcept
+{
+#if defined( __x86_64__ ) && defined( __GNUC__ )
+    static const bool hardware = __builtin_cpu_supports( "sse4.2" );
+    if( hardware )
+    {
+        return ~detail::crc32c_hardware( data, ~crc );
+    }
+#elif defined( __aarch64__ ) && defined( __ARM_FEATURE_CRC32 )
+    return ~detail::crc32c_hardware( data, ~crc );
+#endif
+
+    return ~detail::crc32c_software( data, ~crc );
+}
+
+/**
+ * \brief The number of bytes of a frame header
+ */
+inline constexpr size_t frame_header_size = 32u;
+
+/**
+ * \brief Header of a frame that holds the encoded data of a number of values
+ *
+ * A frame makes golomb data self describing: the decoder knows how many values it decodes, so the zeros that
+ * pad the last word are not mistaken for data, and it can check the data with the checksum.
+ * The header is followed by \em size bytes of encoded data.
+ *
+ * The header is stored in \em frame_header_size bytes, the numbers in big endian byte order:
+ *
+ * Offset | Size | Field
+ * ------ | ---- | ------------------------------------------------------------------
+ *      0 |    4 | The characters 'E', 'G', 'F' and the format version 1
+ *      4 |    1 | \em value_digits, the most significant bit is set for signed values
+ *      5 |    1 | \em word_digits, the most significant bit is set for words in little endian \em word_order
+ *      6 |    1 | \em k
+ *      7 |    1 | \em adaptive, 255 when the values are not encoded adaptively
+ *      8 |    8 | \em count
+ *     16 |    8 | \em size
+ *     24 |    4 | \em crc
+ *     28 |    4 | The CRC32C of the bytes before it in the header
+ */
+struct frame_header
+{
+    uint64_t    count        = {};                  ///< The number of encoded values
+    uint64_t    size         = {};                  ///< The number of bytes of the encoded data
+    uint32_t    crc          = {};                  ///< The CRC32C of the encoded data
+    uint8_t     value_digits = {};                  ///< The number of bits of the values that are encoded
+    bool        value_signed = {};                  ///< True when the encoded values are signed
+    uint8_t     word_digits  = 8u;                  ///< The number of bits of the words of the encoded data
+    uint8_t     k            = {};                  ///< The order, or the initial order of an adaptive encoder
+    int8_t      adaptive     = -1;                  ///< The shift of an adaptive encoder with a \em dynamic_shift policy or -1
+    std::endian word_order   = std::endian::big;    ///< The byte order of the words of the encoded data, see \em encoder
+
+    /**
+     * \brief Returns true when the frame holds values of \em ValueT in words with the byte order \em WordOrder
+     *
+     * Frames with 8 bit words match any \em WordOrder.
+     */
+    template< std::integral ValueT, std::endian WordOrder = std::endian::big >
+    [[nodiscard]] constexpr bool holds() const noexcept
+    {
+        return value_digits == sizeof( ValueT ) * 8u && value_signed == std::is_signed_v< ValueT > &&
+               ( word_order == WordOrder || word_digits == 8u );
+    }
+};
+
+/**
+ * \brief Status of reading a frame header
+ */
+enum frame_status
+{
+    valid,           ///< The header is read
+    truncated,       ///< There are less than \em frame_header_size bytes
+    not_a_frame,     ///< The data does not start with a frame header
+    corrupt_header,  ///< The checksum of the header does not match
+};
+
+/**
+ * \brief Golomb frame_read_result object that holds the header that is read and the status
+ */
+struct frame_read_result
+{
+    frame_header header;
+    frame_status status;
+};
+
+/**
+ * \brief Returns the bytes of a frame header
+ */
+[[nodiscard]] inline std::array< uint8_t, frame_header_size > write_frame_header( const frame_header & header ) noexcept
+{
+    std::array< uint8_t, frame_header_size > data = { 'E', 'G', 'F', 1u };
+
+    data[ 4 ] = static_cast< uint8_t >( header.value_digits | ( header.value_signed ? 0x80u : 0u ) );
+    data[ 5 ] = static_cast< uint8_t >( header.word_digits | ( header.word_order == std::endian::little ? 0x80u : 0u ) );
+    data[ 6 ] = header.k;
+    data[ 7 ] = static_cast< uint8_t >( header.adaptive );
+    detail::store_bytes( &data[ 8 ], header.count, 8 );
+    detail::store_bytes( &data[ 16 ], header.size, 8 );
+    detail::store_bytes( &data[ 24 ], header.crc, 4 );
+    detail::store_bytes( &data[ 28 ], crc32c( std::as_bytes( std::span( data ).first( 28u ) ) ), 4 );
+
+    return data;
+}
+
+/**
+ * \brief Reads a frame header from the begin of data
+ *
+ * \param data  The data that starts with the frame header
+ *
+ * \return A \em frame_read_result struct, the header is only valid when the status is \em valid.
+ */
+[[nodiscard]] inline frame_read_result read_frame_header( std::span< const uint8_t > data ) noexcept
+{
+    if( data.size() < frame_header_size )
+    {
+        return { {}, frame_status::truncated };
+    }
+
+    if( data[ 0 ] != 'E' || data[ 1 ] != 'G' || data[ 2 ] != 'F' || data[ 3 ] != 1u )
+    {
+        return { {}, frame_status::not_a_frame };
+    }
+
+    if( detail::load_bytes( &data[ 28 ], 4 ) != crc32c( std::as_bytes( data.first( 28u ) ) ) )
+    {
+        return { {}, frame_status::corrupt_header };
+    }
+
+    frame_header header;
+    header.value_digits = static_cast< uint8_t >( data[ 4 ] & 0x7Fu );
+    header.value_signed = ( data[ 4 ] & 0x80u ) != 0u;
+    header.word_digits  = static_cast< uint8_t >( data[ 5 ] & 0x7Fu );
+    header.word_order   = ( data[ 5 ] & 0x80u ) != 0u ? std::endian::little : std::endian::big;
+    header.k            = data[ 6 ];
+    header.adaptive     = static_cast< int8_t >( data[ 7 ] );
+    header.count        = detail::load_bytes( &data[ 8 ], 8 );
+    header.size         = detail::load_bytes( &data[ 16 ], 8 );
+    header.crc          = static_cast< uint32_t >( detail::load_bytes( &data[ 24 ], 4 ) );
+
+    return { header, frame_status::valid };
+}
+
+}
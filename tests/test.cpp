@@ -1,9 +1,12 @@
 #include <golomb.h>
+#include <golomb_frame.h>
 #include <cstdint>
 #include <array>
 #include <vector>
+#include <list>
 #include <iostream>
 #include <algorithm>
+#include <string_view>
 
 static int total_checks  = 0;
 static int failed_checks = 0;
@@ -124,6 +127,97 @@ static void encode_narrow_to_wide_k0()
     assert_same( decoded[ 11 ], values[ 11 ] );
 }
 
+static void encode_native_word_order_k0()
+{
+    const std::array< uint8_t, 12 > values = { 0x00u, 0xFFu, 0x00u, 0xFFu,
+                                               0x00u, 0xFFu, 0x00u, 0xFFu,
+                                               0x00u, 0xFFu, 0x00u, 0xFFu };
+    std::vector< uint32_t > result;
+
+    using OutputItT = std::back_insert_iterator< std::vector< uint32_t > >;
+
+    pg::golomb::encoder< OutputItT, uint32_t, std::endian::native > e( std::back_inserter( result ) );
+
+    for( const auto value : values )
+    {
+        e.push< 0u >( value );
+    }
+
+    e.flush();
+
+    // The words hold the bitstream in their native byte order
+    assert_same( result.size(), 4u );
+    assert_same( result[ 0 ], 0x80402010u );
+    assert_same( result[ 1 ], 0x08040201u );
+    assert_same( result[ 2 ], 0x00804020u );
+    assert_same( result[ 3 ], 0x10000000u );
+
+    pg::golomb::decoder< std::vector< uint32_t >::const_iterator, std::endian::native > d( result.cbegin(), result.cend() );
+    std::array< uint8_t, 12 >                                                          decoded;
+
+    const auto [ count, status ] = d.pull_n< uint8_t >( decoded, 0u );
+
+    assert_same( count, values.size() );
+    assert_same( status, pg::golomb::decoder_status::success );
+    assert_true( decoded == values );
+}
+
+// Wide words are byte swapped in constant evaluation too
+static constexpr uint32_t constexpr_encode_wide_k0()
+{
+    const std::array< uint8_t, 2 > values = { 0x00u, 0xFFu };
+    std::array< uint32_t, 1 >      result = {};
+
+    pg::golomb::encode< uint32_t >( values, result.begin() );
+
+    return result[ 0 ];
+}
+
+static_assert( constexpr_encode_wide_k0() == ( std::endian::native == std::endian::big ? 0x80400000u : 0x00004080u ) );
+
+static void encode_contiguous_output_k2()
+{
+    std::vector< int32_t > values;
+    for( int i = 0 ; i < 1000 ; ++i )
+    {
+        values.push_back( ( i % 13 ) * ( i % 2 ? 1 : -1000 ) );
+    }
+
+    std::vector< uint16_t > appended;
+
+    pg::golomb::encode< uint16_t >( values, std::back_inserter( appended ), 2u );
+
+    // Full buffers are stored at once to contiguous output
+    std::vector< uint16_t > contiguous( appended.size() + 1u );
+
+    const auto last = pg::golomb::encode< uint16_t >( values, contiguous.begin(), 2u );
+
+    assert_true( last == contiguous.end() - 1 );
+    assert_true( std::ranges::equal( appended, std::span( contiguous ).first( appended.size() ) ) );
+}
+
+template< typename OutputDataT, typename ElementT >
+static void encode_contiguous_mismatched_words_k2()
+{
+    std::vector< int32_t > values;
+    for( int i = 0 ; i < 1000 ; ++i )
+    {
+        values.push_back( ( i % 13 ) * ( i % 2 ? 1 : -1000 ) );
+    }
+
+    // Each word is written to an element of another type, like appended output does
+    std::vector< ElementT > appended;
+
+    pg::golomb::encode< OutputDataT >( values, std::back_inserter( appended ), 2u );
+
+    std::vector< ElementT > contiguous( appended.size() );
+
+    const auto last = pg::golomb::encode< OutputDataT >( values, contiguous.data(), 2u );
+
+    assert_true( last == contiguous.data() + contiguous.size() );
+    assert_true( std::ranges::equal( appended, contiguous ) );
+}
+
 static void encode_narrow_to_wide_k4()
 {
     const std::array< uint8_t, 8 > values = { 0x00u, 0xFFu, 0x00u, 0xFFu,
@@ -181,6 +275,27 @@ static void encode_narrow_to_wide_k1()
     assert_same( decoded[ 7 ], values[ 7 ] );
 }
 
+static void encode_narrow_to_wide_exact_fill_k0()
+{
+    std::array< uint8_t, 33 > values = {};
+    values.back() = 0x01u;
+
+    std::vector< uint32_t > result;
+
+    pg::golomb::encode< uint32_t >( values.cbegin(), values.cend(), std::back_inserter( result ) );
+
+    assert_same( result.size(), 2u );
+    assert_same( result[ 0 ], 0xFFFFFFFFu );
+    assert_same( result[ 1 ], 0x00000040u );
+
+    std::vector< uint8_t > decoded;
+
+    pg::golomb::decode< uint8_t >( result.cbegin(), result.cend(), std::back_inserter( decoded ) );
+
+    assert_same( decoded.size(), values.size() );
+    assert_true( std::ranges::equal( decoded, values ) );
+}
+
 static void encode_wide_to_narrow_k0()
 {
     const std::array< uint32_t, 2 > values = { 0x00u, 0xFFFFFFFFu };
@@ -292,45 +407,1319 @@ static void decode_wide_to_narrow_k0()
     assert_same( result[ 1 ], 0xFFu );
 }
 
-static void readme()
+static void decode_codeword_exceeds_window_k0()
+{
+    const std::array< uint64_t, 3 > values = { 0x01u, 0xFFFFFFFFFFFFFFFFu, 0x02u };
+    std::vector< uint8_t >          data;
+
+    pg::golomb::encode( values, std::back_inserter( data ) );
+
+    assert_same( data.size(), 17u );
+
+    std::vector< uint64_t > result;
+
+    pg::golomb::decode< uint64_t >( data, std::back_inserter( result ) );
+
+    assert_same( result.size(), 3u );
+    assert_same( result[ 0 ], values[ 0 ] );
+    assert_same( result[ 1 ], values[ 1 ] );
+    assert_same( result[ 2 ], values[ 2 ] );
+}
+
+static void decode_contiguous_and_list_k3()
 {
+    std::vector< int16_t > values;
+    for( int i = -300 ; i < 300 ; i += 7 )
     {
-        const std::array< uint8_t, 8 > values = { 0u, 1u, 2u, 3u, 4u, 255u, 0u, 2u };
+        values.push_back( static_cast< int16_t >( i * i * ( i & 0x01 ? -1 : 1 ) ) );
+    }
 
-        // Encoding using a range as input
-        std::vector< uint8_t > out_range;
+    std::vector< uint16_t > data;
 
-        pg::golomb::encode( values, std::back_inserter( out_range ) );
+    pg::golomb::encode< uint16_t >( values, std::back_inserter( data ), 3u );
 
-        assert_same( out_range.size(), 5 );
+    const std::list< uint16_t > data_list( data.cbegin(), data.cend() );
+    std::vector< int16_t >      from_vector;
+    std::vector< int16_t >      from_list;
 
-        // Encoding using iterators as input
-        std::vector< uint8_t > out_iter;
+    pg::golomb::decode< int16_t >( data, std::back_inserter( from_vector ), 3u );
+    pg::golomb::decode< int16_t >( data_list, std::back_inserter( from_list ), 3u );
 
-        pg::golomb::encode( std::begin( values ), std::end( values ), std::back_inserter( out_iter ) );
+    assert_true( std::ranges::equal( from_vector, values ) );
+    assert_true( std::ranges::equal( from_list, values ) );
+}
 
-        assert_same( out_iter.size(), 5 );
+static void decode_wide_words_k3()
+{
+    std::vector< uint64_t > values;
+    for( uint64_t i = 0u ; i < 300u ; ++i )
+    {
+        values.push_back( i % 13u == 0u ? ~i >> ( i % 64u ) : i * i );
+    }
 
-        assert_true( std::ranges::equal( out_range, out_iter ) );
+    std::vector< uint8_t >  bytes;
+    std::vector< uint64_t > words;
+
+    pg::golomb::encode( values, std::back_inserter( bytes ), 3u );
+    pg::golomb::encode< uint64_t >( values, std::back_inserter( words ), 3u );
+
+    // The words are padded with zeros to a multiple of 8 bytes
+    assert_same( words.size(), ( bytes.size() + 7u ) / 8u );
+
+    const std::list< uint64_t > words_list( words.cbegin(), words.cend() );
+    std::vector< uint64_t >     from_bytes;
+    std::vector< uint64_t >     from_words;
+    std::vector< uint64_t >     from_list;
+
+    pg::golomb::decode< uint64_t >( bytes, std::back_inserter( from_bytes ), 3u );
+    pg::golomb::decode< uint64_t >( words, std::back_inserter( from_words ), 3u );
+    pg::golomb::decode< uint64_t >( words_list, std::back_inserter( from_list ), 3u );
+
+    assert_true( std::ranges::equal( from_bytes, values ) );
+    assert_true( std::ranges::equal( from_words, values ) );
+    assert_true( std::ranges::equal( from_list, values ) );
+}
+
+static void decoder_bit_position_k2()
+{
+    std::vector< uint32_t > values;
+    for( uint32_t i = 0u ; i < 100u ; ++i )
+    {
+        values.push_back( i * i * i );
+    }
+
+    std::vector< uint8_t >  bytes;
+    std::vector< uint64_t > words;
+
+    pg::golomb::encode( values, std::back_inserter( bytes ), 2u );
+    pg::golomb::encode< uint64_t >( values, std::back_inserter( words ), 2u );
+
+    pg::golomb::decoder from_bytes( bytes.cbegin(), bytes.cend() );
+    pg::golomb::decoder from_words( words.cbegin(), words.cend() );
+
+    assert_same( from_bytes.bit_position(), 0u );
+
+    size_t position = 0u;
+    for( const auto value : values )
+    {
+        position += pg::golomb::encoded_bits( value, 2u );
+
+        assert_same( from_bytes.pull< uint32_t >( 2u ).value, value );
+        assert_same( from_words.pull< uint32_t >( 2u ).value, value );
+        assert_same( from_bytes.bit_position(), position );
+        assert_same( from_words.bit_position(), position );
     }
+}
+
+static void decode_into_span_k1()
+{
+    const std::array< uint16_t, 6 > values = { 0u, 1u, 2u, 3u, 200u, 0xFFFFu };
+    std::vector< uint8_t >          data;
+
+    pg::golomb::encode( values, std::back_inserter( data ), 1u );
+
+    std::array< uint16_t, 4 > partial;
+
+    const auto [ partial_count, partial_status ] = pg::golomb::decode_into< uint16_t >( data, partial, 1u );
+
+    assert_same( partial_count, partial.size() );
+    assert_same( partial_status, pg::golomb::decoder_status::success );
+    assert_true( std::ranges::equal( partial, std::span( values ).first( partial.size() ) ) );
+
+    std::array< uint16_t, 8 > all;
+
+    const auto [ all_count, all_status ] = pg::golomb::decode_into< uint16_t >( data, all, 1u );
+
+    assert_same( all_count, values.size() );
+    assert_same( all_status, pg::golomb::decoder_status::done );
+    assert_true( std::ranges::equal( std::span( all ).first( all_count ), values ) );
+}
+
+static void encoder_push_n_k3()
+{
+    std::vector< int32_t > values;
+    for( int i = 0 ; i < 300 ; ++i )
     {
-        const std::array< uint8_t, 5 > data = { 0xA6u, 0x42u, 0x80u, 0x40u, 0x2Cu };
+        values.push_back( ( i % 11 ) * ( i % 3 ? 7 : -70000 ) );
+    }
 
-        // Decoding using a ranges as input
-        std::vector< int16_t > values_range;
+    std::vector< uint8_t > pushed;
+    pg::golomb::encoder    e( std::back_inserter( pushed ) );
 
-        pg::golomb::decode< int16_t >( data, std::back_inserter( values_range ) );
+    for( const auto value : values )
+    {
+        e.push< 3u >( value );
+    }
 
-        assert_same( values_range.size(), 8 );
+    e.flush();
 
-        // Decoding using iterators as input
-        std::vector< int32_t > values_iter;
+    // Blocks of values are appended to the bitstream like values that are pushed one by one
+    const std::span< const int32_t > blocks( values );
+    std::vector< uint8_t >           pushed_n;
+    pg::golomb::encoder              e_n( std::back_inserter( pushed_n ) );
 
-        pg::golomb::decode< int32_t >( std::begin( data ), std::end( data ), std::back_inserter( values_iter ) );
+    e_n.push_n< 3u >( blocks.first( 100u ) );
+    e_n.push_n( blocks.subspan( 100u, 1u ), 3u );
+    e_n.push_n( blocks.subspan( 101u ), 3u );
+    e_n.flush();
 
-        assert_same( values_iter.size(), 8 );
+    assert_true( pushed == pushed_n );
+    assert_same( e_n.size(), pushed.size() );
 
-        assert_true( std::ranges::equal( values_range, values_iter ) );
+    // Contiguous ranges are encoded with push_n by encode
+    const std::list< int32_t > list( values.begin(), values.end() );
+    std::vector< uint8_t >     from_list;
+
+    pg::golomb::encode( list, std::back_inserter( from_list ), 3u );
+
+    assert_true( pushed == from_list );
+}
+
+static void encode_into_span_k1()
+{
+    const std::array< uint16_t, 6 > values = { 0u, 1u, 2u, 3u, 200u, 0xFFFFu };
+    std::vector< uint8_t >          data;
+
+    pg::golomb::encode( values, std::back_inserter( data ), 1u );
+
+    assert_same( data.size(), 8u );
+    assert_same( pg::golomb::max_encoded_size< uint16_t >( values.size(), 1u ), 24u );
+    assert_same( ( pg::golomb::max_encoded_size< uint16_t, uint16_t >( values.size(), 20u ) ), 7u );
+
+    std::array< uint8_t, 8 > all;
+
+    const auto [ all_count, all_size, all_status ] = pg::golomb::encode_into< uint8_t >( values, all, 1u );
+
+    assert_same( all_count, values.size() );
+    assert_same( all_size, data.size() );
+    assert_same( all_status, pg::golomb::encoder_status::encoded );
+    assert_true( std::ranges::equal( all, data ) );
+
+    // The first four values take 12 bits, the fifth value doesn't fit anymore
+    std::array< uint8_t, 3 > partial;
+
+    const auto [ partial_count, partial_size, partial_status ] = pg::golomb::encode_into< uint8_t >( values, partial, 1u );
+
+    assert_same( partial_count, 4u );
+    assert_same( partial_size, 2u );
+    assert_same( partial_status, pg::golomb::encoder_status::output_full );
+
+    std::vector< uint16_t > decoded;
+
+    pg::golomb::decode< uint16_t >( std::span( partial ).first( partial_size ), std::back_inserter( decoded ), 1u );
+
+    assert_true( std::ranges::equal( decoded, std::span( values ).first( partial_count ) ) );
+
+    // Encodes the remaining values in the next span
+    const auto [ rest_count, rest_size, rest_status ] = pg::golomb::encode_into< uint8_t >( std::span( values ).subspan( partial_count ), all, 1u );
+
+    assert_same( rest_count, 2u );
+    assert_same( rest_size, 6u );
+    assert_same( rest_status, pg::golomb::encoder_status::encoded );
+}
+
+static void decoder_pull_n_k2()
+{
+    const std::array< int32_t, 5 > values = { -2, 7, 0, -100, 65536 };
+    std::vector< uint8_t >         data;
+
+    pg::golomb::encode( values, std::back_inserter( data ), 2u );
+
+    pg::golomb::decoder       d( data.cbegin(), data.cend() );
+    std::array< int32_t, 3 > first;
+    std::array< int32_t, 3 > second;
+
+    const auto first_result = d.pull_n< int32_t, 2u >( first );
+    assert_same( first_result.count, first.size() );
+    assert_same( first_result.status, pg::golomb::decoder_status::success );
+
+    const auto second_result = d.pull_n< int32_t >( second, 2u );
+    assert_same( second_result.count, 2u );
+    assert_same( second_result.status, pg::golomb::decoder_status::done );
+
+    assert_same( first[ 0 ], values[ 0 ] );
+    assert_same( first[ 1 ], values[ 1 ] );
+    assert_same( first[ 2 ], values[ 2 ] );
+    assert_same( second[ 0 ], values[ 3 ] );
+    assert_same( second[ 1 ], values[ 4 ] );
+}
+
+template< size_t k >
+static void small_values()
+{
+    std::vector< int16_t > values;
+    for( int i = 0 ; i < 100 ; ++i )
+    {
+        values.push_back( static_cast< int16_t >( i % 5 ? i % 9 - 4 : i * 100 ) );
+    }
+
+    std::vector< uint8_t > compile_time_data;
+    std::vector< uint8_t > runtime_data;
+    pg::golomb::encoder    compile_time_e( std::back_inserter( compile_time_data ) );
+    pg::golomb::encoder    runtime_e( std::back_inserter( runtime_data ) );
+
+    for( const auto value : values )
+    {
+        compile_time_e.template push< k >( value );
+        runtime_e.push( value, k );
+    }
+
+    compile_time_e.flush();
+    runtime_e.flush();
+
+    assert_true( compile_time_data == runtime_data );
+
+    // Decodes with batches that are larger and smaller than the number of values per table lookup
+    for( const size_t batch_size : { 3u, 10u, 200u } )
+    {
+        pg::golomb::decoder    d( compile_time_data.cbegin(), compile_time_data.cend() );
+        std::vector< int16_t > batch( batch_size );
+        std::vector< int16_t > decoded;
+
+        while( true )
+        {
+            const auto [ count, status ] = d.template pull_n< int16_t >( batch, k );
+
+            decoded.insert( decoded.end(), batch.begin(), batch.begin() + static_cast< std::ptrdiff_t >( count ) );
+            if( status != pg::golomb::decoder_status::success )
+            {
+                break;
+            }
+        }
+
+        assert_true( decoded == values );
+    }
+}
+
+static void encode_decode_blocks_k2()
+{
+    std::vector< int32_t > values;
+    for( int i = 0 ; i < 50 ; ++i )
+    {
+        values.push_back( ( i % 7 ) * ( i % 3 ? 1 : -100 ) );
+    }
+
+    std::vector< uint8_t >                 data;
+    std::vector< pg::golomb::block_info > index;
+
+    pg::golomb::encode_blocks( values, std::back_inserter( data ), std::back_inserter( index ), 16u, 2u );
+
+    assert_same( index.size(), 4u );
+    assert_same( index[ 0 ].value_offset, 0u );
+    assert_same( index[ 0 ].data_offset, 0u );
+    assert_same( index[ 1 ].value_offset, 16u );
+    assert_same( index[ 3 ].value_offset, 48u );
+    assert_true( index[ 1 ].data_offset < index[ 2 ].data_offset );
+    assert_true( index[ 3 ].data_offset < data.size() );
+    assert_same( index[ 2 ].k, 2u );
+
+    std::vector< int32_t > all;
+
+    pg::golomb::decode_blocks< int32_t >( data, index, 0u, values.size(), std::back_inserter( all ) );
+
+    assert_true( std::ranges::equal( all, values ) );
+
+    std::vector< int32_t > spanning;
+
+    pg::golomb::decode_blocks< int32_t >( data, index, 14u, 20u, std::back_inserter( spanning ) );
+
+    assert_same( spanning.size(), 20u );
+    assert_true( std::ranges::equal( spanning, std::span( values ).subspan( 14u, 20u ) ) );
+
+    std::vector< int32_t > tail;
+
+    pg::golomb::decode_blocks< int32_t >( data, index, 46u, 10u, std::back_inserter( tail ) );
+
+    assert_same( tail.size(), 4u );
+    assert_true( std::ranges::equal( tail, std::span( values ).subspan( 46u ) ) );
+}
+
+static void adaptive_encode_decode_blocks_s2()
+{
+    std::vector< int32_t > values;
+    for( int i = 0 ; i < 70 ; ++i )
+    {
+        values.push_back( i < 35 ? i % 5 : ( i % 4 ) * 300 - 400 );
+    }
+
+    std::vector< uint16_t >                data;
+    std::vector< pg::golomb::block_info > index;
+
+    pg::golomb::adaptive_encode_blocks< 2u, uint16_t >( values, std::back_inserter( data ), std::back_inserter( index ), 16u, 1u );
+
+    assert_same( index.size(), 5u );
+    assert_same( index[ 0 ].k, 1u );
+
+    // The index holds the order of the adaptation over the whole input at the start of each block
+    using ScratchIt = std::back_insert_iterator< std::vector< uint8_t > >;
+
+    std::vector< uint8_t >                       scratch;
+    pg::golomb::adaptive_encoder< ScratchIt, 2u > e( std::back_inserter( scratch ), 1u );
+    for( size_t i = 0u ; i < values.size() ; ++i )
+    {
+        if( i % 16u == 0u )
+        {
+            assert_same( index[ i / 16u ].k, e.order() );
+        }
+        e.push( values[ i ] );
+    }
+    assert_true( index[ 3 ].k > index[ 1 ].k );
+
+    std::vector< int32_t > all;
+
+    pg::golomb::adaptive_decode_blocks< int32_t, 2u >( data, index, 0u, values.size(), std::back_inserter( all ) );
+
+    assert_true( std::ranges::equal( all, values ) );
+
+    std::vector< int32_t > spanning;
+
+    pg::golomb::adaptive_decode_blocks< int32_t, 2u >( data, index, 30u, 20u, std::back_inserter( spanning ) );
+
+    assert_same( spanning.size(), 20u );
+    assert_true( std::ranges::equal( spanning, std::span( values ).subspan( 30u, 20u ) ) );
+
+    std::vector< int32_t > tail;
+
+    pg::golomb::adaptive_decode_blocks< int32_t, 2u >( data, index, 66u, 10u, std::back_inserter( tail ) );
+
+    assert_same( tail.size(), 4u );
+    assert_true( std::ranges::equal( tail, std::span( values ).subspan( 66u ) ) );
+}
+
+static void adaptive_encode_k0()
+{
+    const std::array< uint8_t, 4 > values = { 0u, 7u, 7u, 0u };
+    std::vector< uint8_t >         result;
+
+    pg::golomb::adaptive_encoder< std::back_insert_iterator< std::vector< uint8_t > >, 1u > e( std::back_inserter( result ) );
+
+    e.push( values[ 0 ] );
+    assert_same( e.order(), 0u );
+    e.push( values[ 1 ] );
+    assert_same( e.order(), 1u );
+    e.push( values[ 2 ] );
+    assert_same( e.order(), 2u );
+    e.push( values[ 3 ] );
+    assert_same( e.order(), 1u );
+    e.flush();
+
+    assert_same( result.size(), 3u );
+    assert_same( result[ 0 ], 0x88u );
+    assert_same( result[ 1 ], 0x26u );
+    assert_same( result[ 2 ], 0x00u );
+
+    std::vector< uint8_t > decoded;
+
+    pg::golomb::adaptive_decode< uint8_t, 1u >( result, std::back_inserter( decoded ) );
+
+    assert_true( std::ranges::equal( decoded, values ) );
+}
+
+static void adaptive_encode_decode_dynamic_shift_k3()
+{
+    std::vector< int16_t > values;
+    for( int i = 0 ; i < 100 ; ++i )
+    {
+        values.push_back( static_cast< int16_t >( ( i % 10 ) * ( i % 10 ) * ( i % 2 ? 1 : -300 ) ) );
+    }
+
+    std::vector< uint8_t > fixed_shift;
+
+    pg::golomb::adaptive_encode< 2u >( values, std::back_inserter( fixed_shift ), 3u );
+
+    std::vector< uint8_t > dynamic_shift;
+
+    pg::golomb::adaptive_encoder< std::back_insert_iterator< std::vector< uint8_t > >, pg::golomb::dynamic_shift > e( std::back_inserter( dynamic_shift ), 3u, 2u );
+    for( const auto value : values )
+    {
+        e.push( value );
+    }
+    e.flush();
+
+    assert_true( fixed_shift == dynamic_shift );
+    assert_same( e.size(), dynamic_shift.size() );
+
+    std::array< int16_t, 128 > decoded = {};
+
+    pg::golomb::adaptive_decoder< std::vector< uint8_t >::const_iterator, pg::golomb::dynamic_shift > d( fixed_shift.cbegin(), fixed_shift.cend(), 3u, 2u );
+
+    const auto result = d.pull_n< int16_t >( decoded );
+
+    assert_same( result.count, values.size() );
+    assert_same( result.status, pg::golomb::decoder_status::done );
+    assert_true( std::ranges::equal( std::span( decoded ).first( result.count ), values ) );
+}
+
+static void adaptation_policies_k2()
+{
+    static_assert( pg::golomb::adaptation_policy< pg::golomb::ema_policy< 2u > > );
+    static_assert( pg::golomb::adaptation_policy< pg::golomb::attack_decay_policy<> > );
+
+    pg::golomb::attack_decay_policy< 1u, 4u > policy;
+
+    policy.update( 8u );
+    assert_same( policy.order(), 3u );
+    policy.update( 8u );
+    assert_same( policy.order(), 5u );
+    policy.update( 0u );
+    assert_same( policy.order(), 4u );
+
+    std::vector< int32_t > values;
+    for( int i = 0 ; i < 200 ; ++i )
+    {
+        values.push_back( i % 50 == 0 ? 100000 : i % 4 - 2 );
+    }
+
+    std::vector< uint8_t > data;
+
+    pg::golomb::adaptive_encode( values, std::back_inserter( data ), pg::golomb::attack_decay_policy<>( 2u ) );
+
+    std::vector< int32_t > decoded;
+
+    pg::golomb::adaptive_decode< int32_t >( data, std::back_inserter( decoded ), pg::golomb::attack_decay_policy<>( 2u ) );
+
+    assert_true( std::ranges::equal( decoded, values ) );
+}
+
+static void optimal_order_k8()
+{
+    const std::vector< uint16_t > zeros( 10u, 0u );
+    const std::vector< uint16_t > nine_digits( 10u, 300u );
+
+    assert_same( pg::golomb::optimal_order( zeros ), 0u );
+    assert_same( pg::golomb::optimal_order( nine_digits ), 7u );     // 300 + 2^8 has 10 digits, 300 + 2^7 has 9
+
+    // Adding 2^k to a value can make it one digit wider, 3 takes 5 bits with order 0 and 4 bits with order 1
+    const std::vector< uint16_t > threes( 1000u, 3u );
+    const std::vector< uint16_t > sevens( 10u, 7u );
+    const std::vector< uint16_t > mixed = { 3u, 3u, 7u, 0u, 15u, 1u, 3u, 6u, 2u, 14u };
+
+    assert_same( pg::golomb::optimal_order( threes ), 2u );
+    assert_same( pg::golomb::optimal_order( sevens ), 3u );
+
+    for( const auto & set : { threes, sevens, mixed, nine_digits } )
+    {
+        size_t best_k = 0u;
+        for( size_t k = 1u ; k < 16u ; ++k )
+        {
+            if( pg::golomb::encoded_bits( set, k ) < pg::golomb::encoded_bits( set, best_k ) )
+            {
+                best_k = k;
+            }
+        }
+
+        assert_same( pg::golomb::optimal_order( set ), best_k );
+    }
+
+    std::vector< uint16_t > values( zeros );
+    values.insert( values.end(), nine_digits.begin(), nine_digits.end() );
+    values.insert( values.end(), 3u, 1u );
+    values.insert( values.end(), 7u, 3u );
+
+    std::vector< uint8_t >                 data;
+    std::vector< pg::golomb::block_info > index;
+
+    pg::golomb::encode_optimal_blocks( values, std::back_inserter( data ), std::back_inserter( index ), 10u );
+
+    assert_same( index.size(), 3u );
+    assert_same( index[ 0 ].k, 0u );
+    assert_same( index[ 1 ].k, 7u );
+    assert_same( index[ 1 ].value_offset, 10u );
+    assert_same( index[ 2 ].k, 2u );
+    assert_same( index[ 2 ].value_offset, 20u );
+
+    std::vector< uint16_t > decoded;
+
+    pg::golomb::decode_blocks< uint16_t >( data, index, 0u, values.size(), std::back_inserter( decoded ) );
+
+    assert_true( std::ranges::equal( decoded, values ) );
+}
+
+template< typename ValueT >
+static void encoded_bits_by_order( const std::vector< ValueT > & values )
+{
+    const auto bits = pg::golomb::encoded_bits_by_order( values );
+
+    assert_same( bits.size(), std::numeric_limits< std::make_unsigned_t< ValueT > >::digits );
+
+    for( size_t k = 0u ; k < bits.size() ; ++k )
+    {
+        std::vector< uint8_t > data;
+        pg::golomb::encoder    e( std::back_inserter( data ) );
+
+        for( const auto value : values )
+        {
+            e.push( value, k );
+        }
+
+        assert_same( bits[ k ], e.bit_size() );
+        assert_same( pg::golomb::encoded_bits( values, k ), e.bit_size() );
+    }
+}
+
+static void encoded_bits_exact()
+{
+    assert_same( pg::golomb::encoded_bits( 0u ), 1u );
+    assert_same( pg::golomb::encoded_bits( 200u, 1u ), 14u );
+    assert_same( pg::golomb::encoded_bits( uint16_t{ 0xFFFFu }, 1u ), 32u );
+    assert_same( pg::golomb::encoded_bits( uint8_t{ 3u }, 100u ), 8u );
+
+    encoded_bits_by_order< int8_t >( { 0, -1, 1, 127, -128, 5, -64 } );
+    encoded_bits_by_order< uint16_t >( { 0u, 1u, 300u, 0x7FFFu, 0xFFFEu, 0xFFFFu } );
+    encoded_bits_by_order< uint64_t >( { 0u, 42u, std::numeric_limits< uint64_t >::max(), std::numeric_limits< uint64_t >::max() - 1000u } );
+}
+
+static void adaptive_encoded_bits_shifts()
+{
+    const std::array< int16_t, 12 > values = { 0, 3, -7, 200, 180, -300, 2, 0, 1, 30000, -5, 9 };
+
+    for( size_t shift = 0u ; shift < 4u ; ++shift )
+    {
+        std::vector< uint8_t > data;
+
+        pg::golomb::adaptive_encoder< std::back_insert_iterator< std::vector< uint8_t > >, pg::golomb::dynamic_shift > e( std::back_inserter( data ), 2u, shift );
+        for( const auto value : values )
+        {
+            e.push( value );
+        }
+        e.flush();
+
+        const auto bits = pg::golomb::adaptive_encoded_bits( values, pg::golomb::ema_policy< pg::golomb::dynamic_shift >( 2u, shift ) );
+        assert_same( ( bits + 7u ) / 8u, data.size() );
+    }
+
+    assert_same( pg::golomb::adaptive_encoded_bits( values, pg::golomb::fixed_order_policy< 3u >() ), pg::golomb::encoded_bits( values, 3u ) );
+}
+
+static void stats_encode_decode_k1()
+{
+    const std::array< int16_t, 6 > values = { 0, 1, -1, 2, 300, 0 };
+    std::vector< uint8_t >         data;
+
+    using OutputItT = std::back_insert_iterator< std::vector< uint8_t > >;
+
+    pg::golomb::stats_encoder e( pg::golomb::encoder< OutputItT >( std::back_inserter( data ) ) );
+
+    for( const auto value : values )
+    {
+        e.push( value, 1u );
+    }
+
+    e.flush();
+
+    const auto & encoded = e.stats();
+
+    assert_same( encoded.values, values.size() );
+    assert_same( encoded.bits, pg::golomb::encoded_bits( values, 1u ) );
+    assert_same( encoded.flushes, 1u );
+    assert_same( encoded.zeros[ 0 ], 3u );
+    assert_same( encoded.zeros[ 1 ], 2u );
+    assert_same( encoded.zeros[ 8 ], 1u );
+
+    pg::golomb::stats_decoder d( pg::golomb::decoder( data.cbegin(), data.cend() ) );
+    std::array< int16_t, 8 >  decoded;
+
+    const auto [ count, status ] = d.pull_n< int16_t >( decoded, 1u );
+
+    assert_same( count, values.size() );
+    assert_same( status, pg::golomb::decoder_status::done );
+    assert_same( d.stats().values, encoded.values );
+    assert_same( d.stats().bits, encoded.bits );
+    assert_true( d.stats().zeros == encoded.zeros );
+
+    // The order changes of an adaptive encoder are counted
+    using AdaptiveEncoderT = pg::golomb::adaptive_encoder< OutputItT, 1u >;
+
+    std::vector< uint8_t > adaptive_data;
+
+    pg::golomb::stats_encoder adaptive_e( AdaptiveEncoderT( std::back_inserter( adaptive_data ) ) );
+
+    for( const auto value : { 0u, 7u, 7u, 0u } )
+    {
+        adaptive_e.push( value );
+    }
+
+    assert_same( adaptive_e.stats().order_changes, 3u );
+
+    pg::golomb::codec_stats total;
+
+    total += encoded;
+    total += adaptive_e.stats();
+
+    assert_same( total.values, 10u );
+    assert_same( total.order_changes, 3u );
+}
+
+static void transform_stages_k0()
+{
+    const std::array< uint32_t, 6 > timestamps = { 1000u, 1010u, 1020u, 1030u, 1041u, 1051u };
+
+    pg::golomb::delta_transform< uint32_t > delta( 1000u );
+
+    assert_same( delta.forward( timestamps[ 0 ] ), 0 );
+    assert_same( delta.forward( timestamps[ 1 ] ), 10 );
+    assert_same( delta.forward( 1005u ), -5 );
+
+    pg::golomb::delta_of_delta_transform< uint32_t > delta_of_delta( 990u );
+
+    assert_same( delta_of_delta.forward( timestamps[ 0 ] ), 10 );
+    assert_same( delta_of_delta.forward( timestamps[ 1 ] ), 0 );
+    assert_same( delta_of_delta.forward( timestamps[ 2 ] ), 0 );
+    assert_same( delta_of_delta.forward( timestamps[ 4 ] ), 11 );
+
+    pg::golomb::xor_transform< int8_t > xor_previous;
+
+    assert_same( xor_previous.forward( -1 ), 0xFFu );
+    assert_same( xor_previous.forward( -2 ), 0x01u );
+
+    pg::golomb::xor_transform< int8_t > xor_restore;
+
+    assert_same( xor_restore.inverse( 0xFFu ), -1 );
+    assert_same( xor_restore.inverse( 0x01u ), -2 );
+
+    const pg::golomb::frame_of_reference_transform< int16_t > frame_of_reference( -100 );
+
+    assert_same( frame_of_reference.forward( -98 ), 2u );
+    assert_same( frame_of_reference.inverse( 5u ), -95 );
+
+    // Delta of delta encoded timestamps are zeros, except for the first timestamp and the irregular step
+    std::vector< uint8_t > data;
+
+    pg::golomb::encode( timestamps, std::back_inserter( data ), 0u, pg::golomb::delta_of_delta_transform< uint32_t >( 990u ) );
+
+    assert_same( data.size(), 3u );
+
+    std::vector< uint32_t > decoded;
+
+    pg::golomb::decode< uint32_t >( data, std::back_inserter( decoded ), 0u, pg::golomb::delta_of_delta_transform< uint32_t >( 990u ) );
+
+    assert_true( std::ranges::equal( decoded, timestamps ) );
+}
+
+static void transform_pipeline_adaptive_k2()
+{
+    using StageT = pg::golomb::transform_pipeline< pg::golomb::frame_of_reference_transform< uint16_t >,
+                                                   pg::golomb::xor_transform< uint16_t > >;
+
+    std::vector< uint16_t > values;
+    for( uint16_t i = 0u ; i < 100u ; ++i )
+    {
+        values.push_back( static_cast< uint16_t >( 40000u + ( i % 9 ) * ( i % 5 ) ) );
+    }
+
+    const StageT stage( { 40000u }, {} );
+
+    std::vector< uint8_t > data;
+    using OutputItT = std::back_insert_iterator< std::vector< uint8_t > >;
+
+    pg::golomb::transform_encoder e( pg::golomb::adaptive_encoder< OutputItT, 1u >( std::back_inserter( data ), 2u ), stage );
+    for( const auto value : values )
+    {
+        e.push( value );
+    }
+    e.flush();
+
+    assert_same( e.size(), data.size() );
+    assert_true( data.size() < values.size() );
+
+    using InputItT = std::vector< uint8_t >::const_iterator;
+
+    pg::golomb::transform_decoder d( pg::golomb::adaptive_decoder< InputItT, 1u >( data.cbegin(), data.cend(), 2u ), stage );
+
+    std::vector< uint16_t > decoded;
+    while( d.has_data() )
+    {
+        const auto [ value, status ] = d.pull();
+        if( status == pg::golomb::decoder_status::success )
+        {
+            decoded.push_back( value );
+        }
+    }
+
+    assert_true( std::ranges::equal( decoded, values ) );
+}
+
+template< typename CodecT >
+static void codec_encode_decode()
+{
+    using ValueT    = typename CodecT::value_type;
+    using WordT     = typename CodecT::word_type;
+    using OutputItT = std::back_insert_iterator< std::vector< WordT > >;
+
+    std::vector< ValueT > values;
+    for( int i = 0 ; i < 300 ; ++i )
+    {
+        values.push_back( static_cast< ValueT >( ( i % 13 ) * ( i % 7 ) * ( i < 150 ? 1 : 40 ) - ( i % 3 ) * 5 ) );
+    }
+
+    const typename CodecT::transform_type stage;
+
+    // The same code as the encoder with a runtime order and shift
+    std::vector< WordT > expected;
+
+    if constexpr( CodecT::is_adaptive )
+    {
+        pg::golomb::transform_encoder e( pg::golomb::adaptive_encoder< OutputItT, pg::golomb::dynamic_shift, WordT >( std::back_inserter( expected ), CodecT::order, CodecT::shift ), stage );
+        for( const auto value : values )
+        {
+            e.push( value );
+        }
+        e.flush();
+    }
+    else
+    {
+        pg::golomb::transform_encoder e( pg::golomb::encoder< OutputItT, WordT >( std::back_inserter( expected ) ), stage );
+        for( const auto value : values )
+        {
+            e.push( value, CodecT::order );
+        }
+        e.flush();
+    }
+
+    std::vector< WordT > data;
+
+    CodecT::encode( values, std::back_inserter( data ), stage );
+
+    assert_true( std::ranges::equal( data, expected ) );
+
+    std::vector< ValueT > decoded;
+
+    CodecT::decode( data, std::back_inserter( decoded ), stage );
+
+    assert_true( std::ranges::equal( decoded, values ) );
+
+    std::vector< ValueT > span_decoded( values.size() + 1u );
+
+    const auto [ count, status ] = CodecT::decode_into( data, std::span( span_decoded ), stage );
+
+    assert_same( count, values.size() );
+    assert_same( status, pg::golomb::decoder_status::done );
+    assert_true( std::ranges::equal( std::span( span_decoded ).first( count ), values ) );
+
+    // A decoder wrapped in a stats decoder, which has no compile time batch pull
+    if constexpr( std::same_as< typename CodecT::transform_type, pg::golomb::identity_transform< ValueT > > )
+    {
+        pg::golomb::stats_decoder d( CodecT::make_decoder( data.cbegin(), data.cend() ) );
+
+        std::vector< ValueT > stats_decoded( values.size() );
+
+        const auto result = CodecT::pull_n( d, std::span( stats_decoded ) );
+
+        assert_same( result.count, values.size() );
+        assert_true( std::ranges::equal( stats_decoded, values ) );
+        assert_same( d.stats().values, values.size() );
+
+        if constexpr( CodecT::is_adaptive )
+        {
+            assert_same( d.stats().bits, pg::golomb::adaptive_encoded_bits( values, pg::golomb::ema_policy< CodecT::shift >( CodecT::order ) ) );
+        }
+        else
+        {
+            assert_same( d.stats().bits, pg::golomb::adaptive_encoded_bits( values, pg::golomb::fixed_order_policy< CodecT::order >() ) );
+        }
+    }
+}
+
+static void multi_lane_encode_decode()
+{
+    struct record
+    {
+        uint32_t timestamp_delta;
+        uint16_t id;
+        int32_t  value;
+    };
+
+    std::vector< record > records;
+    for( uint16_t i = 0u ; i < 50u ; ++i )
+    {
+        records.push_back( { 10u + i % 3u, static_cast< uint16_t >( 300u + i % 7u ), ( i % 5 - 2 ) * ( i < 25u ? 1 : 1000 ) } );
+    }
+
+    using LanesT = std::tuple< pg::golomb::fixed_order_policy< 3u >,
+                               pg::golomb::fixed_order_policy< pg::golomb::dynamic_order >,
+                               pg::golomb::ema_policy< 1u > >;
+
+    const LanesT lanes( {}, { 8u }, { 2u } );
+
+    std::vector< uint8_t > data;
+
+    pg::golomb::multi_lane_encoder e( std::back_inserter( data ), lanes );
+    for( const auto & r : records )
+    {
+        e.push( r.timestamp_delta, r.id, r.value );
+    }
+    e.flush();
+
+    // The lanes are interleaved in a single bitstream
+    std::vector< uint8_t > expected;
+
+    pg::golomb::encoder single( std::back_inserter( expected ) );
+    size_t                 k = 2u;
+    for( const auto & r : records )
+    {
+        single.push( r.timestamp_delta, 3u );
+        single.push( r.id, 8u );
+        single.push( pg::golomb::to_unsigned( r.value ), k );
+        k = k - ( k >> 1 ) + ( std::bit_width( pg::golomb::to_unsigned( r.value ) ) >> 1 );
+    }
+    single.flush();
+
+    assert_true( data == expected );
+    assert_same( e.size(), data.size() );
+
+    pg::golomb::multi_lane_decoder d( data.cbegin(), data.cend(), lanes );
+
+    std::vector< record > decoded;
+    for( record r ; d.pull( r.timestamp_delta, r.id, r.value ) == pg::golomb::decoder_status::success ; )
+    {
+        decoded.push_back( r );
+    }
+
+    assert_same( decoded.size(), records.size() );
+    assert_true( std::ranges::equal( decoded, records, []( const record & a, const record & b )
+    {
+        return a.timestamp_delta == b.timestamp_delta && a.id == b.id && a.value == b.value;
+    } ) );
+}
+
+template< typename InputDataT >
+static void stream_decode_chunks()
+{
+    std::vector< uint64_t > values;
+    for( uint64_t i = 0u ; i < 200u ; ++i )
+    {
+        values.push_back( i % 17u == 0u ? ~i : ( i * i ) % 50u );
+    }
+
+    std::vector< InputDataT > data;
+
+    pg::golomb::encode< InputDataT >( values, std::back_inserter( data ), 2u );
+
+    // Feed chunks of varying sizes from a buffer that is overwritten after each chunk
+    pg::golomb::stream_decoder< InputDataT > d;
+    std::vector< uint64_t >                  decoded;
+    std::array< InputDataT, 7 >              buffer;
+
+    int chunks     = 0;
+    int need_input = 0;
+    for( size_t position = 0u, size = 0u ; position < data.size() ; position += size )
+    {
+        size = std::min( data.size() - position, position % buffer.size() + 1u );
+        std::copy( data.begin() + position, data.begin() + position + size, buffer.begin() );
+
+        d.feed( std::span( buffer ).first( size ) );
+
+        auto result = d.template pull< uint64_t >( 2u );
+        for( ; result.status == pg::golomb::decoder_status::success ; result = d.template pull< uint64_t >( 2u ) )
+        {
+            decoded.push_back( result.value );
+        }
+
+        ++chunks;
+        need_input += result.status == pg::golomb::decoder_status::need_input;
+        buffer.fill( 0xAAu );
+    }
+
+    d.finish();
+
+    assert_same( d.template pull< uint64_t >( 2u ).status, pg::golomb::decoder_status::done );
+    assert_same( need_input, chunks );
+    assert_true( std::ranges::equal( decoded, values ) );
+}
+
+static void stream_decode_incomplete_in_scratch_k24()
+{
+    // An incomplete codeword of which the words are fed in separate chunks runs out of input in the scratch buffer
+    const std::array< uint16_t, 2 > data = { 0x8000u, 0x0200u };
+
+    pg::golomb::stream_decoder< uint16_t > d;
+
+    d.feed( std::span( data ).first( 1u ) );
+    assert_same( d.template pull< int64_t >( 24u ).status, pg::golomb::decoder_status::need_input );
+
+    d.feed( std::span( data ).subspan( 1u ) );
+    assert_same( d.template pull< int64_t >( 24u ).status, pg::golomb::decoder_status::need_input );
+
+    d.finish();
+
+    assert_same( d.template pull< int64_t >( 24u ).status, pg::golomb::decoder_status::done );
+}
+
+template< typename InputDataT >
+static void stream_decode_random_chunks()
+{
+    uint32_t random = 12345u;
+    const auto next = [ & ]()
+    {
+        random = random * 1664525u + 1013904223u;
+        return random >> 8;
+    };
+
+    for( size_t k = 0u ; k < 40u ; k += 3u )
+    {
+        std::vector< uint64_t > values;
+        for( int i = 0 ; i < 300 ; ++i )
+        {
+            const auto digits = next() % 65u;
+            values.push_back( digits ? ( uint64_t{ next() } << 32 | next() ) >> ( 64u - digits ) : 0u );
+        }
+
+        std::vector< InputDataT > data;
+
+        pg::golomb::encode< InputDataT >( values, std::back_inserter( data ), k );
+
+        // The codewords end in a truncated codeword that is only completed by the end of the input
+        data.pop_back();
+
+        pg::golomb::stream_decoder< InputDataT > d;
+        std::vector< uint64_t >                  decoded;
+
+        auto status = pg::golomb::decoder_status::need_input;
+        for( size_t position = 0u, size = 0u ; position < data.size() ; position += size )
+        {
+            size = std::min< size_t >( data.size() - position, next() % 9u + 1u );
+
+            // Each chunk has its own allocation that is released after the chunk is decoded
+            const std::vector< InputDataT > chunk( data.begin() + position, data.begin() + position + size );
+
+            d.feed( chunk );
+
+            auto result = d.template pull< uint64_t >( k );
+            for( ; result.status == pg::golomb::decoder_status::success ; result = d.template pull< uint64_t >( k ) )
+            {
+                decoded.push_back( result.value );
+            }
+
+            status = result.status;
+            if( status != pg::golomb::decoder_status::need_input )
+            {
+                break;
+            }
+        }
+
+        assert_same( status, pg::golomb::decoder_status::need_input );
+
+        d.finish();
+
+        for( auto result = d.template pull< uint64_t >( k ) ; result.status != pg::golomb::decoder_status::done ; result = d.template pull< uint64_t >( k ) )
+        {
+            if( result.status == pg::golomb::decoder_status::success )
+            {
+                decoded.push_back( result.value );
+            }
+        }
+
+        assert_true( decoded.size() <= values.size() );
+        assert_true( std::ranges::equal( decoded, std::span( values ).first( decoded.size() ) ) );
+    }
+}
+
+// The pages only take words of their own type, an encoder with another word type doesn't compile
+static_assert( std::output_iterator< pg::golomb::chunked_buffer< uint8_t >::append_iterator, uint8_t > );
+static_assert( !std::output_iterator< pg::golomb::chunked_buffer< uint8_t >::append_iterator, uint16_t > );
+static_assert( !std::output_iterator< pg::golomb::chunked_buffer< uint16_t >::append_iterator, uint8_t > );
+
+template< typename DataT, size_t PageSize >
+static void chunked_buffer_reuse()
+{
+    std::vector< uint32_t > values;
+    for( uint32_t i = 0u ; i < 300u ; ++i )
+    {
+        values.push_back( i % 13u == 0u ? ~i : ( i * 7u ) % 90u );
+    }
+
+    std::vector< DataT > expected;
+    pg::golomb::encode< DataT >( values, std::back_inserter( expected ), 3u );
+
+    pg::golomb::chunked_buffer< DataT, PageSize > buffer;
+    assert_true( buffer.empty() );
+
+    buffer.commit( pg::golomb::encode< DataT >( values, buffer.appender(), 3u ) );
+    assert_same( buffer.size(), expected.size() );
+    assert_same( buffer.chunk_count(), ( expected.size() + PageSize - 1u ) / PageSize );
+
+    std::vector< DataT > gathered;
+    for( auto chunk : buffer.chunks() )
+    {
+        gathered.insert( gathered.end(), chunk.begin(), chunk.end() );
+    }
+    assert_true( gathered == expected );
+
+    // The second message is written to the same pages
+    const auto capacity   = buffer.capacity();
+    const auto first_page = buffer.chunk( 0u ).data();
+
+    buffer.clear();
+    assert_true( buffer.empty() );
+
+    using OutputItT = typename pg::golomb::chunked_buffer< DataT, PageSize >::append_iterator;
+
+    pg::golomb::encoder< OutputItT, DataT > e( buffer.appender() );
+    for( const auto value : values )
+    {
+        e.template push< 3u >( value );
+    }
+    buffer.commit( e.flush() );
+
+    assert_same( e.size(), buffer.size() );
+    assert_same( buffer.capacity(), capacity );
+    assert_same( buffer.chunk( 0u ).data(), first_page );
+    assert_same( buffer.size(), expected.size() );
+
+    pg::golomb::stream_decoder< DataT > d;
+    std::vector< uint32_t >             decoded;
+    for( auto chunk : buffer.chunks() )
+    {
+        d.feed( chunk );
+        for( auto result = d.template pull< uint32_t >( 3u ) ; result.status == pg::golomb::decoder_status::success ; result = d.template pull< uint32_t >( 3u ) )
+        {
+            decoded.push_back( result.value );
+        }
+    }
+
+    assert_true( decoded == values );
+
+    // An appender continues after the committed data
+    buffer.commit( pg::golomb::encode< DataT >( values, buffer.appender(), 3u ) );
+    assert_same( buffer.size(), 2u * expected.size() );
+
+    gathered.clear();
+    for( auto chunk : buffer.chunks() )
+    {
+        gathered.insert( gathered.end(), chunk.begin(), chunk.end() );
+    }
+    assert_true( std::equal( expected.begin(), expected.end(), gathered.begin() ) );
+    assert_true( std::equal( expected.begin(), expected.end(), gathered.begin() + expected.size() ) );
+}
+
+static void crc32c_known_values()
+{
+    const std::string_view digits = "123456789";
+
+    assert_same( pg::golomb::crc32c( std::as_bytes( std::span( digits ) ) ), 0xE3069283u );
+    assert_same( pg::golomb::crc32c( {} ), 0u );
+
+    // Long enough for the parts that are calculated at the same time, with an odd tail
+    std::vector< uint8_t > data( 50001u );
+    for( size_t i = 0u ; i < data.size() ; ++i )
+    {
+        data[ i ] = static_cast< uint8_t >( i * 131u + i / 7u );
+    }
+
+    const auto bytes = std::as_bytes( std::span( data ) );
+    const auto crc   = pg::golomb::crc32c( bytes );
+
+    assert_same( crc, ~pg::golomb::detail::crc32c_software( bytes, ~0u ) );
+    assert_same( pg::golomb::crc32c( bytes.subspan( 12345u ), pg::golomb::crc32c( bytes.first( 12345u ) ) ), crc );
+}
+
+static void frame_header_roundtrip()
+{
+    pg::golomb::frame_header header;
+    header.count        = 0x0102030405060708u;
+    header.size         = 1234567u;
+    header.crc          = 0xE3069283u;
+    header.value_digits = 16u;
+    header.value_signed = true;
+    header.word_digits  = 64u;
+    header.k            = 3u;
+    header.adaptive     = 2;
+
+    auto data = pg::golomb::write_frame_header( header );
+    assert_same( data.size(), pg::golomb::frame_header_size );
+    assert_same( data[ 8 ], 0x01u );
+    assert_same( data[ 15 ], 0x08u );
+
+    const auto [ read, status ] = pg::golomb::read_frame_header( data );
+    assert_same( status, pg::golomb::frame_status::valid );
+    assert_same( read.count, header.count );
+    assert_same( read.size, header.size );
+    assert_same( read.crc, header.crc );
+    assert_same( read.value_digits, header.value_digits );
+    assert_true( read.holds< int16_t >() );
+    assert_true( !read.holds< uint16_t >() );
+    assert_same( read.word_digits, header.word_digits );
+    assert_same( read.word_order, std::endian::big );
+    assert_same( read.k, header.k );
+    assert_same( read.adaptive, header.adaptive );
+
+    // Words in native byte order on a little endian platform don't hold big endian data
+    header.word_order = std::endian::little;
+
+    const auto little = pg::golomb::read_frame_header( pg::golomb::write_frame_header( header ) ).header;
+    assert_same( little.word_order, std::endian::little );
+    assert_same( little.word_digits, header.word_digits );
+    assert_true( !little.holds< int16_t >() );
+    assert_true( ( little.holds< int16_t, std::endian::little >() ) );
+
+    header.word_digits = 8u;
+    assert_true( pg::golomb::read_frame_header( pg::golomb::write_frame_header( header ) ).header.holds< int16_t >() );
+
+    header.word_order  = std::endian::big;
+    header.word_digits = 64u;
+
+    header.adaptive = -1;
+    assert_same( pg::golomb::read_frame_header( pg::golomb::write_frame_header( header ) ).header.adaptive, -1 );
+
+    assert_same( pg::golomb::read_frame_header( std::span( data ).first( 31u ) ).status, pg::golomb::frame_status::truncated );
+
+    data[ 9 ] ^= 0x10u;
+    assert_same( pg::golomb::read_frame_header( data ).status, pg::golomb::frame_status::corrupt_header );
+
+    data[ 0 ] = 'X';
+    assert_same( pg::golomb::read_frame_header( data ).status, pg::golomb::frame_status::not_a_frame );
+}
+
+static void readme()
+{
+    {
+        const std::array< uint8_t, 8 > values = { 0u, 1u, 2u, 3u, 4u, 255u, 0u, 2u };
+
+        // Encoding using a range as input
+        std::vector< uint8_t > out_range;
+
+        pg::golomb::encode( values, std::back_inserter( out_range ) );
+
+        assert_same( out_range.size(), 5 );
+
+        // Encoding using iterators as input
+        std::vector< uint8_t > out_iter;
+
+        pg::golomb::encode( std::begin( values ), std::end( values ), std::back_inserter( out_iter ) );
+
+        assert_same( out_iter.size(), 5 );
+
+        assert_true( std::ranges::equal( out_range, out_iter ) );
+    }
+    {
+        const std::array< uint8_t, 8 > values = { 0u, 1u, 2u, 3u, 4u, 255u, 0u, 2u };
+
+        // Encoding into caller owned memory that is large enough for any values
+        std::array< uint8_t, pg::golomb::max_encoded_size< uint8_t >( values.size() ) > data;
+
+        const auto [ count, size, status ] = pg::golomb::encode_into< uint8_t >( values, data );
+
+        assert_same( count, 8u );
+        assert_same( size, 5u );
+        assert_same( status, pg::golomb::encoder_status::encoded );
+    }
+    {
+        const std::array< uint8_t, 5 > data = { 0xA6u, 0x42u, 0x80u, 0x40u, 0x2Cu };
+
+        // Decoding using a ranges as input
+        std::vector< int16_t > values_range;
+
+        pg::golomb::decode< int16_t >( data, std::back_inserter( values_range ) );
+
+        assert_same( values_range.size(), 8 );
+
+        // Decoding using iterators as input
+        std::vector< int32_t > values_iter;
+
+        pg::golomb::decode< int32_t >( std::begin( data ), std::end( data ), std::back_inserter( values_iter ) );
+
+        assert_same( values_iter.size(), 8 );
+
+        assert_true( std::ranges::equal( values_range, values_iter ) );
+    }
+    {
+        const std::array< uint8_t, 5 > data = { 0xA6u, 0x42u, 0x80u, 0x40u, 0x2Cu };
+
+        // Decoding into a span
+        std::array< int16_t, 16 > values;
+
+        const auto [ count, status ] = pg::golomb::decode_into< int16_t >( data, values );
+
+        assert_same( count, 8u );
+        assert_same( status, pg::golomb::decoder_status::done );
+    }
+    {
+        std::vector< uint16_t > values( 100000u, 3u );
+
+        // Encoding in blocks with an index
+        std::vector< uint8_t >                 data;
+        std::vector< pg::golomb::block_info > index;
+
+        pg::golomb::encode_blocks( values, std::back_inserter( data ), std::back_inserter( index ), 4096u );
+
+        // Decoding a part of the values
+        std::vector< uint16_t > some_values;
+
+        pg::golomb::decode_blocks< uint16_t >( data, index, 50000u, 1000u, std::back_inserter( some_values ) );
+
+        assert_same( some_values.size(), 1000u );
+    }
+    {
+        const std::array< int32_t, 8 > values = { 0, 1, 200, 180, 210, 3, -2, 0 };
+
+        // Encoding with an order that adapts to the values, the filter factor is 2^2
+        std::vector< uint8_t > data;
+
+        pg::golomb::adaptive_encode< 2u >( values, std::back_inserter( data ) );
+
+        // Decoding with the same initial order and filter factor
+        std::vector< int32_t > decoded;
+
+        pg::golomb::adaptive_decode< int32_t, 2u >( data, std::back_inserter( decoded ) );
+
+        assert_true( std::ranges::equal( decoded, values ) );
+    }
+    {
+        const std::array< uint32_t, 6 > timestamps = { 1000u, 1010u, 1020u, 1030u, 1041u, 1051u };
+
+        // Encoding the differences between the steps of the timestamps
+        std::vector< uint8_t > data;
+
+        pg::golomb::encode( timestamps, std::back_inserter( data ), 0u, pg::golomb::delta_of_delta_transform< uint32_t >( 990u ) );
+
+        // Decoding and restoring the timestamps
+        std::vector< uint32_t > decoded;
+
+        pg::golomb::decode< uint32_t >( data, std::back_inserter( decoded ), 0u, pg::golomb::delta_of_delta_transform< uint32_t >( 990u ) );
+
+        assert_true( std::ranges::equal( decoded, timestamps ) );
+    }
+    {
+        const std::array< uint32_t, 6 > values = { 1000u, 1010u, 1020u, 1030u, 1041u, 1051u };
+
+        // 32 bit values in 16 bit words, order 3 that adapts with a filter shift of 2 and a delta transform
+        using codec = pg::golomb::codec< uint32_t, uint16_t, 3u, 2u, pg::golomb::delta_transform< uint32_t > >;
+
+        std::vector< uint16_t > data;
+
+        codec::encode( values, std::back_inserter( data ) );
+
+        std::vector< uint32_t > decoded;
+
+        codec::decode( data, std::back_inserter( decoded ) );
+
+        assert_true( std::ranges::equal( decoded, values ) );
+    }
+    {
+        const std::array< uint32_t, 5 > values = { 3u, 0u, 70000u, 12u, 5u };
+        const size_t                    k      = 2u;
+
+        std::vector< uint8_t > data;
+        pg::golomb::encode( values, std::back_inserter( data ), k );
+
+        pg::golomb::frame_header header;
+        header.count        = values.size();
+        header.size         = data.size();
+        header.crc          = pg::golomb::crc32c( std::as_bytes( std::span( data ) ) );
+        header.value_digits = 32;
+        header.k            = k;
+
+        const auto header_data = pg::golomb::write_frame_header( header );
+
+        // At the receiver
+        const auto [ received, status ] = pg::golomb::read_frame_header( header_data );
+        assert_true( status == pg::golomb::frame_status::valid && received.holds< uint32_t >() &&
+                     pg::golomb::crc32c( std::as_bytes( std::span( data ) ) ) == received.crc );
+
+        std::vector< uint32_t > decoded( received.count );
+        pg::golomb::decoder d( data.begin(), data.end() );
+        assert_same( d.pull_n< uint32_t >( decoded, received.k ).count, values.size() );
+        assert_true( std::ranges::equal( decoded, values ) );
     }
 }
 
@@ -341,14 +1730,60 @@ int main()
     encode_overflow_k2();
     encode_narrow_to_wide_k0();
     encode_narrow_to_wide_k4();
+    encode_native_word_order_k0();
+    encode_contiguous_output_k2();
+    encode_contiguous_mismatched_words_k2< uint8_t, uint32_t >();
+    encode_contiguous_mismatched_words_k2< uint16_t, uint64_t >();
+    encode_contiguous_mismatched_words_k2< uint32_t, uint8_t >();
     encode_wide_to_narrow_k0();
     encode_wide_to_narrow_k3();
     encode_narrow_to_wide_k1();
+    encode_narrow_to_wide_exact_fill_k0();
     decode_all_zeros_k0();
     decode_overflow_k0();
     decode_overflow_k2();
     decode_narrow_to_wide_k0();
     decode_wide_to_narrow_k0();
+    decode_codeword_exceeds_window_k0();
+    decode_contiguous_and_list_k3();
+    decode_wide_words_k3();
+    decoder_bit_position_k2();
+    decode_into_span_k1();
+    encoder_push_n_k3();
+    encode_into_span_k1();
+    decoder_pull_n_k2();
+    small_values< 0u >();
+    small_values< 1u >();
+    small_values< 2u >();
+    encode_decode_blocks_k2();
+    adaptive_encode_decode_blocks_s2();
+    adaptive_encode_k0();
+    adaptive_encode_decode_dynamic_shift_k3();
+    adaptation_policies_k2();
+    optimal_order_k8();
+    encoded_bits_exact();
+    adaptive_encoded_bits_shifts();
+    stats_encode_decode_k1();
+    transform_stages_k0();
+    transform_pipeline_adaptive_k2();
+    codec_encode_decode< pg::golomb::codec< int32_t > >();
+    codec_encode_decode< pg::golomb::codec< int32_t, uint16_t, 3u > >();
+    codec_encode_decode< pg::golomb::codec< uint64_t, uint64_t, 5u > >();
+    codec_encode_decode< pg::golomb::codec< int16_t, uint8_t, 2u, 1u > >();
+    codec_encode_decode< pg::golomb::codec< uint32_t, uint32_t, 4u, pg::golomb::no_adaptation, pg::golomb::delta_transform< uint32_t > > >();
+    codec_encode_decode< pg::golomb::codec< int32_t, uint8_t, 0u, 2u, pg::golomb::xor_transform< int32_t > > >();
+    multi_lane_encode_decode();
+    stream_decode_chunks< uint8_t >();
+    stream_decode_chunks< uint16_t >();
+    stream_decode_chunks< uint64_t >();
+    stream_decode_incomplete_in_scratch_k24();
+    stream_decode_random_chunks< uint16_t >();
+    stream_decode_random_chunks< uint64_t >();
+    chunked_buffer_reuse< uint8_t, 5u >();
+    chunked_buffer_reuse< uint8_t, 65536u >();
+    chunked_buffer_reuse< uint16_t, 8u >();
+    crc32c_known_values();
+    frame_header_roundtrip();
     readme();
 
     std::cout << "Total tests: " << total_checks << ", Tests failed: " << failed_checks << '\n';
@@ -21,6 +21,7 @@
 // SOFTWARE.
 
 #include <golomb.h>
+#include <golomb_frame.h>
 #include <bit>
 #include <iterator>
 #include <string>
@@ -30,7 +31,33 @@
 #include <cstdarg>
 #include <cctype>
 #include <cstdio>
-
+#include <vector>
+#include <span>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <cerrno>
+#if defined( _WIN32 )
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Opt-in clones of the encoding and decoding functions for x86-64 CPUs with BMI2 and LZCNT, build with
+// 'make GOLOMB_TARGET_CLONES=1'. The clone for the CPU is selected by the dynamic linker when the program starts,
+// other targets and builds without the option use the portable code.
+#if defined( GOLOMB_TARGET_CLONES ) && defined( __x86_64__ ) && defined( __GNUC__ ) && !defined( __clang__ ) && defined( __ELF__ )
+#define GOLOMB_HOT_FUNCTION __attribute__(( target_clones( "arch=x86-64-v3", "default" ) ))
+#else
+#define GOLOMB_HOT_FUNCTION
+#endif
 
 static void golomb_argument_error( const char * const format, ... )
 {
@@ -105,134 +132,533 @@ private:
     const char *        opt;
 };
 
+constexpr size_t io_buffer_size = 1u << 20;    // Size in bytes of the buffers that are used to read and write files
+constexpr size_t pipeline_depth = 3u;          // Number of buffers that are handed between the I/O thread and the codec
+
+// The I/O threads only help when they run on other processors than the codec.
+[[nodiscard]] static bool use_io_threads() noexcept
+{
+    return std::thread::hardware_concurrency() > 1u;
+}
+
+// Buffer with values that is handed between threads, a null buffer marks the end.
 template< typename T >
-struct binary_input_file_iterator
+struct io_chunk
 {
-    using difference_type   = std::ptrdiff_t;
-    using value_type        = T;
-    using pointer           = T *;
-    using reference         = T &;
-    using iterator_category = std::input_iterator_tag;
+    std::vector< T > * buffer;
+    size_t             count;
+    int                error;   // The errno of a failed read or zero
+};
 
-    [[nodiscard]] binary_input_file_iterator( std::FILE * file = nullptr )
-        : file( file )
+// Queue through which the chunks are handed from one thread to another without copying the values.
+template< typename T >
+class chunk_queue
+{
+    std::mutex                 mutex;
+    std::condition_variable    ready;
+    std::deque< io_chunk< T > > chunks;
+
+public:
+    void push( io_chunk< T > chunk )
     {
-        if( file )
         {
-            next();
+            const std::lock_guard lock( mutex );
+
+            chunks.push_back( chunk );
         }
+
+        ready.notify_one();
     }
 
-    [[nodiscard]] bool operator==( const binary_input_file_iterator & other ) const
+    // Waits until a chunk is available and removes it from the queue.
+    [[nodiscard]] io_chunk< T > pop()
     {
-        if( file == nullptr || other.file == nullptr )
-        {
-            return file == other.file;
-        }
+        std::unique_lock lock( mutex );
+
+        ready.wait( lock, [ this ]() { return !chunks.empty(); } );
 
-        return file == other.file && std::ftell( file ) == std::ftell( other.file );
+        const auto chunk = chunks.front();
+        chunks.pop_front();
+
+        return chunk;
     }
+};
 
-    [[nodiscard]] bool operator!=( const binary_input_file_iterator & other ) const
+// Runs 'code' with 'coder', or with 'coder' wrapped in 'StatsT' when statistics are collected in 'stats'.
+template< template< typename > class StatsT, typename CoderT, typename CodeT >
+static void with_stats( CoderT & coder, pg::golomb::codec_stats * stats, const CodeT & code )
+{
+    if( stats )
     {
-        return !operator==( other );
+        StatsT< CoderT & > wrapped( coder );
+
+        code( wrapped );
+        *stats += wrapped.stats();
+    }
+    else
+    {
+        code( coder );
     }
+}
 
-    const value_type &           operator*()  const noexcept { return value; }
-    binary_input_file_iterator * operator->() const noexcept { return &value; }
-    binary_input_file_iterator & operator++() noexcept       { next(); return *this; }
-    binary_input_file_iterator   operator++( int ) noexcept  { auto it = *this; next(); return it; }
+// Read-only memory mapping of a regular file.
+// The file is not mapped when it is not a regular file, is empty or when mapping fails.
+struct mapped_file
+{
+    [[nodiscard]] mapped_file( std::FILE * file ) noexcept
+    {
+#if defined( _WIN32 )
+        const auto    handle = reinterpret_cast< HANDLE >( _get_osfhandle( _fileno( file ) ) );
+        LARGE_INTEGER file_size;
 
-private:
-    std::FILE * file  = nullptr;
-    T           value = T();
+        if( handle == INVALID_HANDLE_VALUE || GetFileType( handle ) != FILE_TYPE_DISK ||
+            !GetFileSizeEx( handle, &file_size ) || file_size.QuadPart == 0 )
+        {
+            return;
+        }
 
-    void next()
-    {
-        assert( file != nullptr );
+        mapping = CreateFileMappingW( handle, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        if( mapping == nullptr )
+        {
+            return;
+        }
 
-        if( std::fread( &value, sizeof( T ), 1, file ) )
+        data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+        if( data == nullptr )
         {
+            CloseHandle( mapping );
+            mapping = nullptr;
             return;
         }
-        else if( std::feof( file ) )
+
+        size = static_cast< size_t >( file_size.QuadPart );
+#else
+        const int   fd = fileno( file );
+        struct stat status;
+
+        // The mapping starts at the begin of the file, which must also be the current position of the file
+        if( fstat( fd, &status ) != 0 || !S_ISREG( status.st_mode ) || status.st_size == 0 ||
+            lseek( fd, 0, SEEK_CUR ) != 0 )
         {
-            file = nullptr;
             return;
         }
 
-        if( const int err = std::ferror( file ) )
+        void * const address = mmap( nullptr, static_cast< size_t >( status.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+        if( address == MAP_FAILED )
         {
-            golomb_errno( "Input" );
+            return;
+        }
+
+        madvise( address, static_cast< size_t >( status.st_size ), MADV_SEQUENTIAL );
+
+        data = address;
+        size = static_cast< size_t >( status.st_size );
+#endif
+    }
+
+    mapped_file( const mapped_file & ) = delete;
+    mapped_file & operator=( const mapped_file & ) = delete;
+
+    ~mapped_file()
+    {
+        if( data == nullptr )
+        {
+            return;
         }
+
+#if defined( _WIN32 )
+        UnmapViewOfFile( data );
+        CloseHandle( mapping );
+#else
+        munmap( data, size );
+#endif
+    }
+
+    // Returns the whole values that fit in the mapped file, an empty span when the file is not mapped.
+    template< typename T >
+    [[nodiscard]] std::span< const T > values() const noexcept
+    {
+        return std::span< const T >( static_cast< const T * >( data ), size / sizeof( T ) );
     }
+
+private:
+#if defined( _WIN32 )
+    HANDLE mapping = nullptr;
+#endif
+    void * data    = nullptr;
+    size_t size    = 0u;
 };
 
+// Reads values from a file in chunks.
+// The chunks are taken directly from memory when the file can be mapped. Otherwise a reader thread reads the next
+// chunks in buffers while the current chunk is processed, or the chunks are read in a buffer on a single processor.
 template< typename T >
 struct binary_input_file
 {
-    using value_type      = T;
-    using const_pointer   = const T *;
-    using const_reference = const T &;
-    using difference_type = std::ptrdiff_t;
-    using iterator        = binary_input_file_iterator< T >;
+    [[nodiscard]] binary_input_file( std::FILE * file, size_t chunk_size = io_buffer_size / sizeof( T ) )
+        : file( file )
+        , mapping( file )
+        , remaining( mapping.template values< T >() )
+        , chunk_size( chunk_size )
+        , current( nullptr )
+        , ended( false )
+    {
+        if( remaining.empty() && use_io_threads() )
+        {
+            buffers.resize( pipeline_depth, std::vector< T >( chunk_size ) );
+            for( auto & buffer : buffers )
+            {
+                free_buffers.push( { &buffer, 0u, 0 } );
+            }
 
-    std::FILE * file  = nullptr;
+            reader = std::thread( [ this ]() { read_file(); } );
+        }
+        else if( remaining.empty() )
+        {
+            buffers.resize( 1u, std::vector< T >( chunk_size ) );
+        }
+    }
 
-    [[nodiscard]] binary_input_file( std::FILE * file ) noexcept
-        : file( file )
-    {}
+    binary_input_file( const binary_input_file & ) = delete;
+    binary_input_file & operator=( const binary_input_file & ) = delete;
+
+    ~binary_input_file()
+    {
+        if( reader.joinable() )
+        {
+            // Unblocks the reader when it waits for a buffer
+            free_buffers.push( { nullptr, 0u, 0 } );
+            reader.join();
+        }
+    }
+
+    // Returns all values of the file when it is mapped in memory, or else an empty span.
+    [[nodiscard]] std::span< const T > mapped() const noexcept
+    {
+        return mapping.template values< T >();
+    }
 
-    [[nodiscard]] auto begin() const noexcept -> iterator
+    // Reads the next chunk of values, the previous chunk is not valid anymore.
+    // An empty span is returned when the end of the file is reached.
+    [[nodiscard]] std::span< const T > read()
     {
-        return iterator( file );
+        if( !remaining.empty() )
+        {
+            const auto chunk = remaining.first( std::min( chunk_size, remaining.size() ) );
+
+            remaining = remaining.subspan( chunk.size() );
+
+            return chunk;
+        }
+
+        if( buffers.empty() || ended )
+        {
+            return {};
+        }
+
+        if( !reader.joinable() )
+        {
+            auto &     buffer = buffers.front();
+            const auto count  = std::fread( buffer.data(), sizeof( T ), buffer.size(), file );
+            if( std::ferror( file ) )
+            {
+                golomb_errno( "Input" );
+            }
+
+            return std::span< const T >( buffer.data(), count );
+        }
+
+        if( current )
+        {
+            free_buffers.push( { current, 0u, 0 } );
+        }
+
+        const auto chunk = filled.pop();
+        if( chunk.error )
+        {
+            errno = chunk.error;
+            golomb_errno( "Input" );
+        }
+
+        current = chunk.buffer;
+        ended   = chunk.count == 0u;
+
+        return std::span< const T >( current->data(), chunk.count );
     }
 
-    [[nodiscard]] auto end() const noexcept -> iterator
+private:
+    std::FILE *                     file;
+    mapped_file                     mapping;
+    std::span< const T >            remaining;
+    size_t                          chunk_size;
+    std::vector< std::vector< T > > buffers;
+    chunk_queue< T >                free_buffers;
+    chunk_queue< T >                filled;
+    std::vector< T > *              current;    // The buffer of the chunk that was read last
+    bool                            ended;
+    std::thread                     reader;
+
+    // Runs on the reader thread, fills the free buffers until the end of the file is reached or reading fails.
+    void read_file()
     {
-        return iterator();
+        for( auto chunk = free_buffers.pop() ; chunk.buffer ; chunk = free_buffers.pop() )
+        {
+            chunk.count = std::fread( chunk.buffer->data(), sizeof( T ), chunk.buffer->size(), file );
+            chunk.error = std::ferror( file ) ? errno : 0;
+
+            filled.push( chunk );
+            if( chunk.count == 0u || chunk.error )
+            {
+                return;
+            }
+        }
     }
 };
 
+// Input iterator for the values of a 'binary_input_file'.
+// A default constructed iterator marks the end of the file.
 template< typename T >
-struct binary_output_file_iterator
+struct binary_input_file_iterator
 {
     using difference_type   = std::ptrdiff_t;
-    using value_type        = void;
-    using pointer           = void;
-    using reference         = void;
-    using iterator_category = std::output_iterator_tag;
+    using value_type        = T;
+    using pointer           = const T *;
+    using reference         = const T &;
+    using iterator_category = std::input_iterator_tag;
+
+    [[nodiscard]] binary_input_file_iterator() noexcept = default;
+
+    [[nodiscard]] binary_input_file_iterator( binary_input_file< T > & file )
+        : file( &file )
+    {
+        next_chunk();
+    }
+
+    [[nodiscard]] bool operator==( const binary_input_file_iterator & other ) const noexcept
+    {
+        if( file == nullptr || other.file == nullptr )
+        {
+            return current == last && other.current == other.last;
+        }
+
+        return current == other.current;
+    }
+
+    [[nodiscard]] bool operator!=( const binary_input_file_iterator & other ) const noexcept
+    {
+        return !operator==( other );
+    }
+
+    // Holds the value of postfix increment because the buffer may be refilled by the increment
+    struct postfix_value
+    {
+        value_type value;
+
+        const value_type & operator*() const noexcept { return value; }
+    };
+
+    const value_type &           operator*()  const noexcept { return *current; }
+    const value_type *           operator->() const noexcept { return current; }
+    binary_input_file_iterator & operator++()                { next(); return *this; }
+    postfix_value                operator++( int )           { const postfix_value v{ *current }; next(); return v; }
+
+private:
+    binary_input_file< T > * file    = nullptr;
+    const T *                current = nullptr;
+    const T *                last    = nullptr;
+
+    void next()
+    {
+        assert( current != last );
+
+        if( ++current == last )
+        {
+            next_chunk();
+        }
+    }
+
+    void next_chunk()
+    {
+        const auto chunk = file->read();
 
-    [[nodiscard]] binary_output_file_iterator( std::FILE * file = nullptr ) noexcept
+        current = chunk.data();
+        last    = chunk.data() + chunk.size();
+    }
+};
+
+// Writes values to a file through buffers in memory.
+// A writer thread writes the filled buffers to the file while the next buffer is filled, on a single processor the
+// buffer is written when it is full.
+template< typename T >
+struct binary_output_file
+{
+    [[nodiscard]] binary_output_file( std::FILE * file )
         : file( file )
-    {}
+        , buffers( use_io_threads() ? pipeline_depth : 1u, std::vector< T >( io_buffer_size / sizeof( T ) ) )
+        , current( &buffers.front() )
+        , size( 0u )
+        , error( 0 )
+    {
+        for( size_t i = 1u ; i < buffers.size() ; ++i )
+        {
+            free_buffers.push( { &buffers[ i ], 0u, 0 } );
+        }
+
+        if( buffers.size() > 1u )
+        {
+            writer = std::thread( [ this ]() { write_file(); } );
+        }
+    }
+
+    binary_output_file( const binary_output_file & ) = delete;
+    binary_output_file & operator=( const binary_output_file & ) = delete;
+
+    ~binary_output_file()
+    {
+        if( writer.joinable() )
+        {
+            filled.push( { nullptr, 0u, 0 } );
+            writer.join();
+        }
+    }
 
-    T operator=( T value ) noexcept
+    void write( T value )
     {
-        assert( file );
+        ( *current )[ size++ ] = value;
+        if( size == current->size() )
+        {
+            hand_off();
+        }
+    }
 
-        if( std::fwrite( &value, sizeof( T ), 1, file ) != 1 )
+    // Writes a chunk of values directly to the file, bypassing the buffers.
+    void write( std::span< const T > values )
+    {
+        flush();
+        if( std::fwrite( values.data(), sizeof( T ), values.size(), file ) != values.size() )
         {
-            std::perror( "output" );
-            std::exit( errno );
+            golomb_errno( "Output" );
         }
+    }
 
-        return value;
+    // Returns the free space of the buffer, values written to it are added with 'commit'.
+    [[nodiscard]] std::span< T > space() noexcept
+    {
+        return std::span< T >( *current ).subspan( size );
     }
 
-    [[nodiscard]] bool operator==( const binary_output_file_iterator & other ) const noexcept
+    // Adds 'count' values that are written to 'space'.
+    void commit( size_t count )
     {
-        if( file == nullptr || other.file == nullptr )
+        size += count;
+        if( size == current->size() )
+        {
+            hand_off();
+        }
+    }
+
+    // Waits until all values are written to the file.
+    void flush()
+    {
+        if( size )
+        {
+            hand_off();
+        }
+
+        if( !writer.joinable() )
+        {
+            return;
+        }
+
+        // All the other buffers are free when the writer is done
+        std::array< io_chunk< T >, pipeline_depth - 1u > idle;
+        for( auto & chunk : idle )
+        {
+            chunk = free_buffers.pop();
+        }
+        for( const auto & chunk : idle )
         {
-            return file == other.file;
+            free_buffers.push( chunk );
         }
 
-        return file == other.file && std::ftell( file ) == std::ftell( other.file );
+        check_error();
     }
 
-    [[nodiscard]] bool operator!=( const binary_output_file_iterator & other ) const noexcept
+private:
+    std::FILE *                     file;
+    std::vector< std::vector< T > > buffers;
+    chunk_queue< T >                free_buffers;
+    chunk_queue< T >                filled;
+    std::vector< T > *              current;
+    size_t                          size;
+    std::atomic< int >              error;      // The errno of a failed write or zero
+    std::thread                     writer;
+
+    // Hands the current buffer to the writer and continues with a free buffer.
+    void hand_off()
     {
-        return !operator==( other );
+        if( !writer.joinable() )
+        {
+            if( std::fwrite( current->data(), sizeof( T ), size, file ) != size )
+            {
+                golomb_errno( "Output" );
+            }
+
+            size = 0u;
+            return;
+        }
+
+        filled.push( { current, size, 0 } );
+
+        current = free_buffers.pop().buffer;
+        size    = 0u;
+
+        check_error();
+    }
+
+    void check_error()
+    {
+        if( const int e = error.load() )
+        {
+            errno = e;
+            golomb_errno( "Output" );
+        }
+    }
+
+    // Runs on the writer thread, writes the filled buffers until the end is marked.
+    void write_file()
+    {
+        for( auto chunk = filled.pop() ; chunk.buffer ; chunk = filled.pop() )
+        {
+            if( !error.load() && std::fwrite( chunk.buffer->data(), sizeof( T ), chunk.count, file ) != chunk.count )
+            {
+                error.store( errno );
+            }
+
+            free_buffers.push( chunk );
+        }
+    }
+};
+
+// Output iterator that writes values to a 'binary_output_file'.
+template< typename T >
+struct binary_output_file_iterator
+{
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = void;
+    using pointer           = void;
+    using reference         = void;
+    using iterator_category = std::output_iterator_tag;
+
+    [[nodiscard]] binary_output_file_iterator( binary_output_file< T > & file ) noexcept
+        : file( &file )
+    {}
+
+    binary_output_file_iterator & operator=( T value )
+    {
+        file->write( value );
+
+        return *this;
     }
 
     binary_output_file_iterator & operator*() noexcept       { return *this; }
@@ -240,19 +666,19 @@ struct binary_output_file_iterator
     binary_output_file_iterator   operator++( int ) noexcept { return *this; }
 
 private:
-    std::FILE * file = nullptr;
+    binary_output_file< T > * file;
 };
 
 
 static void print_help()
 {
     const char * const help =
-        "golomb v1.0.0\n"
+        "golomb v1.1.0\n"
         "\n"
         "A tool to compress or expand binary data using Exponential Golomb Encoding.\n"
         "\n"
         "SYNOPSIS\n"
-        "    golomb [-aN] [-{e|d}[FORMAT]] [-h] [-kN] input output\n"
+        "    golomb [-aN] [-{e|d}[FORMAT]] [-f] [-h] [-jN] [-kN] [-pN] [-v] [-wN] input output\n"
         "\n"
         "DESCRIPTION\n"
         "    golomb reduces the size of its input by using Exponential Golomb Encoding\n"
@@ -273,8 +699,15 @@ static void print_help()
         "    -aN         Enable adaptive mode with factor 'N', must be a positive number.\n"
         "    -e[FORMAT]  Encode and specifies the input format, default format is 'u8'.\n"
         "    -d[FORMAT]  Decode and specifies the output format, default format is 'u8'.\n"
+        "    -f          Encode in a frame or decode a frame, see FRAME.\n"
         "    -h          Shows this help.\n"
+        "    -jN         Enable block mode with 'N' parallel jobs, must be larger than 0.\n"
         "    -kN         Order 'N', must be a positive number. Default is '0'.\n"
+        "    -k auto     Choose the order with the least encoded bits, implies 'f'.\n"
+        "    -pN         Decode a stream with 'N' parallel jobs, must be larger than 0.\n"
+        "    -v          Prints statistics about the values to the standard error.\n"
+        "    -wN         Word size of 'N' bits of the encoded data; 8, 16, 32 or 64.\n"
+        "                Default is '8'.\n"
         "\n"
         "ADAPTIVE MODE\n"
         "    When adaptive mode is anabled the golomb order automatically is adjusted"
@@ -291,6 +724,58 @@ static void print_help()
         "\n"
         "    You must use the same adaptive mode to decode glomb data as it was encoded.\n"
         "\n"
+        "BLOCK MODE\n"
+        "    In block mode the data is split in blocks of 65536 values that are encoded\n"
+        "    or decoded independently by 'N' parallel jobs. Each encoded block starts\n"
+        "    with its size in bytes as a 32 bit big endian number. The order and the\n"
+        "    adaptive mode restart at the begin of each block.\n"
+        "\n"
+        "    Data encoded in block mode must also be decoded in block mode, the number\n"
+        "    of jobs may differ.\n"
+        "\n"
+        "PARALLEL STREAM DECODING\n"
+        "    With option 'p' data that is not encoded in block mode is decoded by 'N'\n"
+        "    parallel jobs. The data is split in segments of 1 MiB that are decoded\n"
+        "    from their first word, where probably no codeword starts. The codewords\n"
+        "    soon start at the same bits as when decoded from the begin of the data.\n"
+        "    The values of a segment are corrected where its decoding matches the end\n"
+        "    of the previous segment. When they don't match the segment is decoded\n"
+        "    again.\n"
+        "\n"
+        "    The input must be a regular file, otherwise it is decoded by one job.\n"
+        "    Parallel stream decoding cannot be combined with adaptive mode.\n"
+        "\n"
+        "STATISTICS\n"
+        "    With option 'v' the number of values, the number of encoded bits, the\n"
+        "    number of flushes, zero overflows and order changes in adaptive mode, the\n"
+        "    wall time and the throughput of the values are printed. A histogram shows\n"
+        "    how many values were encoded with a number of zeros in front of the\n"
+        "    codeword. The statistics help to choose the order and the adaptive mode.\n"
+        "\n"
+        "WORD SIZE\n"
+        "    The encoded data is written and read in words of 'N' bits. Larger words\n"
+        "    reduce the number of writes and reads per value. The bits are stored in big\n"
+        "    endian byte order, so the data only differs in the zeros that pad the last\n"
+        "    word. Data encoded with a word size can be decoded with the same or a\n"
+        "    smaller word size. In block mode the blocks are always decoded per byte.\n"
+        "\n"
+        "FRAME\n"
+        "    With option 'f' the encoded data is preceded by a header of 32 bytes with\n"
+        "    the number of values, the format, the word size, the order, the adaptive\n"
+        "    mode and a CRC32C checksum of the encoded data. The encoded data is kept in\n"
+        "    memory until the header is written.\n"
+        "\n"
+        "    A frame is decoded with the format, order and adaptive mode of its header,\n"
+        "    the options for these are ignored. Decoding fails when the checksum does\n"
+        "    not match. A frame cannot be combined with block mode and parallel stream\n"
+        "    decoding.\n"
+        "\n"
+        "    With '-k auto' the order is chosen that encodes a sample of the input with\n"
+        "    the least bits. The sample consists of 16 windows of 4096 values spread\n"
+        "    over the input, or over the first MiB when the input is not a regular file.\n"
+        "    In adaptive mode also the filter factor is chosen, the factor of option 'a'\n"
+        "    only enables adaptive mode. The choice is stored in the frame header.\n"
+        "\n"
         "FORMAT\n"
         "    The following formats are supported:\n"
         "\n"
@@ -343,6 +828,28 @@ static void print_help()
         "\n"
         "        cat file1 | golomb -ei8 - file\n"
         "\n"
+        "    Encode signed 32 bit values from 'file1' in block mode using 8 jobs.\n"
+        "\n"
+        "        golomb -ei32 -j8 file1 file2\n"
+        "\n"
+        "    Encode unsigned 16 bit values from 'file1' and write the data in 64 bit words.\n"
+        "\n"
+        "        golomb -eu16 -w64 file1 file2\n"
+        "\n"
+        "    Encode signed 32 bit values from 'file1' in a frame and decode the frame.\n"
+        "\n"
+        "        golomb -ei32 -k2 -f file1 file2\n"
+        "        golomb -di32 -f file2 file3\n"
+        "\n"
+        "    Encode unsigned 32 bit values from 'file1' in adaptive mode with the order\n"
+        "    and filter factor chosen from the values.\n"
+        "\n"
+        "        golomb -eu32 -k auto -a0 file1 file2\n"
+        "\n"
+        "    Decode signed 16 bit values from 'file1' with 4 parallel jobs.\n"
+        "\n"
+        "        golomb -di16 -p4 file1 file2\n"
+        "\n"
         "    Decode from from input 'file' and write the results the to standard output.\n"
         "\n"
         "        golomb -di8 file -\n";
@@ -414,8 +921,30 @@ enum class data_type
     return order;
 }
 
+[[nodiscard]] static int decode_jobs_arg( char option, std::string_view j ) noexcept
+{
+    auto       begin = j.data();
+    const auto end   = begin + j.size();
+    int        jobs  = {};
+
+    const auto [ pos_ptr, ec ] = std::from_chars( begin, end, jobs );
+    if( pos_ptr == begin || pos_ptr != end || jobs < 1 )
+    {
+        golomb_argument_error( "Invalid argument for option '%c'.", option );
+    }
+
+    return jobs;
+}
+
+constexpr size_t auto_order = std::numeric_limits< size_t >::max();     // The order of '-k auto'
+
 [[nodiscard]] static size_t decode_k_arg( std::string_view k ) noexcept
 {
+    if( k == "auto" )
+    {
+        return auto_order;
+    }
+
     auto       begin = k.data();
     const auto end   = begin + k.size();
     size_t     order = {};
@@ -429,95 +958,1157 @@ enum class data_type
     return order;
 }
 
-template< typename InputValueT, typename OutputDataT >
-static void adaptive_encode( std::FILE * const in_file,
-                             std::FILE * const out_file,
+[[nodiscard]] static int decode_word_size_arg( std::string_view w ) noexcept
+{
+    auto       begin = w.data();
+    const auto end   = begin + w.size();
+    int        bits  = {};
+
+    const auto [ pos_ptr, ec ] = std::from_chars( begin, end, bits );
+    if( pos_ptr == begin || pos_ptr != end || !( bits == 8 || bits == 16 || bits == 32 || bits == 64 ) )
+    {
+        golomb_argument_error( "Invalid argument for option 'w'." );
+    }
+
+    return bits;
+}
+
+// Stream mode
+
+// The orders below 'kernel_orders' are encoded and decoded by kernels of which all codec parameters are known at
+// compile time, other orders use the kernels of which the order is a runtime argument.
+constexpr size_t kernel_orders = 8u;
+
+// Encodes all values from 'input' with the codec 'CodecT'.
+template< typename CodecT >
+GOLOMB_HOT_FUNCTION
+static void codec_encode( binary_input_file< typename CodecT::value_type > & input,
+                          binary_output_file< typename CodecT::word_type > & output,
+                          pg::golomb::codec_stats * stats )
+{
+    using OutputItT = binary_output_file_iterator< typename CodecT::word_type >;
+
+    auto e = CodecT::make_encoder( OutputItT( output ) );
+
+    with_stats< pg::golomb::stats_encoder >( e, stats, [ & ]( auto & e )
+    {
+        for( auto values = input.read() ; !values.empty() ; values = input.read() )
+        {
+            for( const auto value : values )
+            {
+                CodecT::push( e, value );
+            }
+        }
+
+        e.flush();
+    } );
+}
+
+// Table with the kernel that 'make_kernel' returns for 'codec< ValueT, WordT, k >', indexed by the order k.
+template< typename ValueT, typename WordT, typename MakeKernelT, size_t... K >
+consteval auto make_kernels( const MakeKernelT & make_kernel, std::index_sequence< K... > )
+{
+    return std::array{ make_kernel.template operator()< pg::golomb::codec< ValueT, WordT, K > >()... };
+}
+
+template< typename InputValueT, typename OutputDataT >
+GOLOMB_HOT_FUNCTION
+static void stream_encode( std::FILE * const in_file,
+                           std::FILE * const out_file,
+                           size_t k,
+                           int adaptive,
+                           pg::golomb::codec_stats * stats )
+{
+    using OutputItT = binary_output_file_iterator< OutputDataT >;
+
+    static constexpr auto kernels = make_kernels< InputValueT, OutputDataT >( []< typename CodecT >() { return &codec_encode< CodecT >; },
+                                                                              std::make_index_sequence< kernel_orders >{} );
+
+    binary_input_file< InputValueT >  input( in_file );
+    binary_output_file< OutputDataT > output( out_file );
+
+    if( adaptive < 0 && k < kernels.size() )
+    {
+        kernels[ k ]( input, output, stats );
+    }
+    else if( adaptive >= 0 )
+    {
+        pg::golomb::adaptive_encoder< OutputItT, pg::golomb::dynamic_shift, OutputDataT > e{ OutputItT( output ), k, static_cast< size_t >( adaptive ) };
+
+        with_stats< pg::golomb::stats_encoder >( e, stats, [ & ]( auto & e )
+        {
+            for( auto values = input.read() ; !values.empty() ; values = input.read() )
+            {
+                for( const auto value : values )
+                {
+                    e.push( value );
+                }
+            }
+
+            e.flush();
+        } );
+    }
+    else
+    {
+        pg::golomb::encoder< OutputItT, OutputDataT > e{ OutputItT( output ) };
+
+        with_stats< pg::golomb::stats_encoder >( e, stats, [ & ]( auto & e )
+        {
+            for( auto values = input.read() ; !values.empty() ; values = input.read() )
+            {
+                for( const auto value : values )
+                {
+                    e.push( value, k );
+                }
+            }
+
+            e.flush();
+        } );
+    }
+
+    output.flush();
+}
+
+// Writes the values that 'pull_n' decodes to 'output' until all values are decoded.
+// The values are decoded directly in the buffers of 'output'.
+template< typename OutputValueT, typename PullT >
+static void write_values( binary_output_file< OutputValueT > & output, const PullT & pull_n )
+{
+    for( auto status = pg::golomb::decoder_status::success ; status != pg::golomb::decoder_status::done ; )
+    {
+        const auto result = pull_n( output.space() );
+
+        output.commit( result.count );
+        status = result.status;
+    }
+}
+
+// Decodes all values from the input range [first, last) with the codec 'CodecT' and writes them to 'output'.
+template< typename CodecT, typename InputIt >
+GOLOMB_HOT_FUNCTION
+static void codec_decode( InputIt first,
+                          InputIt last,
+                          binary_output_file< typename CodecT::value_type > & output,
+                          pg::golomb::codec_stats * stats )
+{
+    auto d = CodecT::make_decoder( first, last );
+
+    with_stats< pg::golomb::stats_decoder >( d, stats, [ & ]( auto & d )
+    {
+        write_values( output, [ & ]( std::span< typename CodecT::value_type > values ) { return CodecT::pull_n( d, values ); } );
+    } );
+}
+
+// Decodes all values from the input range [first, last) and writes them to 'output'.
+template< typename OutputValueT, typename InputIt >
+GOLOMB_HOT_FUNCTION
+static void decode_values( InputIt first,
+                           InputIt last,
+                           binary_output_file< OutputValueT > & output,
+                           size_t k,
+                           int adaptive,
+                           pg::golomb::codec_stats * stats )
+{
+    using InputDataT = typename std::iterator_traits< InputIt >::value_type;
+
+    static constexpr auto kernels = make_kernels< OutputValueT, InputDataT >( []< typename CodecT >() { return &codec_decode< CodecT, InputIt >; },
+                                                                              std::make_index_sequence< kernel_orders >{} );
+
+    if( adaptive < 0 && k < kernels.size() )
+    {
+        kernels[ k ]( first, last, output, stats );
+    }
+    else if( adaptive >= 0 )
+    {
+        pg::golomb::adaptive_decoder< InputIt, pg::golomb::dynamic_shift > d( first, last, k, static_cast< size_t >( adaptive ) );
+
+        with_stats< pg::golomb::stats_decoder >( d, stats, [ & ]( auto & d )
+        {
+            write_values( output, [ & ]( std::span< OutputValueT > values ) { return d.template pull_n< OutputValueT >( values ); } );
+        } );
+    }
+    else
+    {
+        pg::golomb::decoder d( first, last );
+
+        with_stats< pg::golomb::stats_decoder >( d, stats, [ & ]( auto & d )
+        {
+            write_values( output, [ & ]( std::span< OutputValueT > values ) { return d.template pull_n< OutputValueT >( values, k ); } );
+        } );
+    }
+}
+
+template< typename InputDataT, typename OutputValueT >
+static void stream_decode( std::FILE * const in_file,
+                           std::FILE * const out_file,
+                           size_t k,
+                           int adaptive,
+                           pg::golomb::codec_stats * stats )
+{
+    using InputItT = binary_input_file_iterator< InputDataT >;
+
+    binary_input_file< InputDataT >    input( in_file );
+    binary_output_file< OutputValueT > output( out_file );
+
+    if( const auto data = input.mapped() ; !data.empty() )
+    {
+        // Decode directly from memory
+        decode_values( data.data(), data.data() + data.size(), output, k, adaptive, stats );
+    }
+    else
+    {
+        decode_values( InputItT( input ), InputItT(), output, k, adaptive, stats );
+    }
+
+    output.flush();
+}
+
+// Block mode
+
+constexpr size_t block_size     = 65536u;   // Number of values per block
+constexpr size_t blocks_per_job = 4u;       // Number of blocks per job that are read in one go
+
+// Runs 'task' for each index in the range [0, n_tasks) on at most 'jobs' threads.
+template< typename TaskT >
+static void run_parallel( int jobs, size_t n_tasks, const TaskT & task )
+{
+    std::atomic< size_t > next_task = {};
+
+    const auto worker = [ & ]()
+    {
+        for( size_t i = next_task++ ; i < n_tasks ; i = next_task++ )
+        {
+            task( i );
+        }
+    };
+
+    std::vector< std::thread > threads;
+    for( size_t i = 1u ; i < std::min( static_cast< size_t >( jobs ), n_tasks ) ; ++i )
+    {
+        threads.emplace_back( worker );
+    }
+
+    worker();
+
+    for( auto & thread : threads )
+    {
+        thread.join();
+    }
+}
+
+template< typename DataT >
+static void write_block( std::FILE * const out_file, const std::vector< DataT > & block )
+{
+    const auto    size      = static_cast< uint32_t >( block.size() * sizeof( DataT ) );
+    const uint8_t header[4] = { static_cast< uint8_t >( size >> 24 ), static_cast< uint8_t >( size >> 16 ),
+                                static_cast< uint8_t >( size >> 8 ),  static_cast< uint8_t >( size ) };
+
+    if( std::fwrite( header, sizeof( header ), 1, out_file ) != 1 ||
+        std::fwrite( block.data(), sizeof( DataT ), block.size(), out_file ) != block.size() )
+    {
+        golomb_errno( "Output" );
+    }
+}
+
+// Reads a block, returns false when there are no more blocks available.
+[[nodiscard]] static bool read_block( std::FILE * const in_file, std::vector< uint8_t > & block )
+{
+    uint8_t header[4];
+
+    const auto header_size = std::fread( header, 1, sizeof( header ), in_file );
+    if( header_size != sizeof( header ) )
+    {
+        if( std::ferror( in_file ) )
+        {
+            golomb_errno( "Input" );
+        }
+        if( header_size )
+        {
+            golomb_argument_error( "Input: block truncated." );
+        }
+
+        return false;
+    }
+
+    const auto size = ( static_cast< uint32_t >( header[ 0 ] ) << 24 ) | ( static_cast< uint32_t >( header[ 1 ] ) << 16 ) |
+                      ( static_cast< uint32_t >( header[ 2 ] ) << 8 )  |   static_cast< uint32_t >( header[ 3 ] );
+
+    block.resize( size );
+    if( std::fread( block.data(), 1, block.size(), in_file ) != block.size() )
+    {
+        if( std::ferror( in_file ) )
+        {
+            golomb_errno( "Input" );
+        }
+
+        golomb_argument_error( "Input: block truncated." );
+    }
+
+    return true;
+}
+
+template< typename InputValueT, typename OutputDataT >
+GOLOMB_HOT_FUNCTION
+static void encode_block( std::span< const InputValueT > values,
+                          std::vector< OutputDataT > & block,
+                          size_t k,
+                          int adaptive,
+                          pg::golomb::codec_stats * stats )
+{
+    using OutputItT = std::back_insert_iterator< std::vector< OutputDataT > >;
+
+    block.clear();
+
+    if( adaptive >= 0 )
+    {
+        pg::golomb::adaptive_encoder< OutputItT, pg::golomb::dynamic_shift, OutputDataT > e( std::back_inserter( block ), k, static_cast< size_t >( adaptive ) );
+
+        with_stats< pg::golomb::stats_encoder >( e, stats, [ & ]( auto & e )
+        {
+            for( const auto value : values )
+            {
+                e.push( value );
+            }
+
+            e.flush();
+        } );
+    }
+    else
+    {
+        pg::golomb::encoder< OutputItT, OutputDataT > e( std::back_inserter( block ) );
+
+        with_stats< pg::golomb::stats_encoder >( e, stats, [ & ]( auto & e )
+        {
+            for( const auto value : values )
+            {
+                e.push( value, k );
+            }
+
+            e.flush();
+        } );
+    }
+}
+
+template< typename OutputValueT >
+GOLOMB_HOT_FUNCTION
+static void decode_block( const std::vector< uint8_t > & block,
+                          std::vector< OutputValueT > & values,
+                          size_t k,
+                          int adaptive,
+                          pg::golomb::codec_stats * stats )
+{
+    using InputItT = std::vector< uint8_t >::const_iterator;
+
+    values.clear();
+
+    if( adaptive >= 0 )
+    {
+        pg::golomb::adaptive_decoder< InputItT, pg::golomb::dynamic_shift > d( block.cbegin(), block.cend(), k, static_cast< size_t >( adaptive ) );
+
+        with_stats< pg::golomb::stats_decoder >( d, stats, [ & ]( auto & d )
+        {
+            while( d.has_data() )
+            {
+                const auto [ value, status ] = d.template pull< OutputValueT >();
+                if( status == pg::golomb::decoder_status::success )
+                {
+                    values.push_back( value );
+                }
+            }
+        } );
+    }
+    else
+    {
+        pg::golomb::decoder d( block.cbegin(), block.cend() );
+
+        with_stats< pg::golomb::stats_decoder >( d, stats, [ & ]( auto & d )
+        {
+            while( d.has_data() )
+            {
+                const auto [ value, status ] = d.template pull< OutputValueT >( k );
+                if( status == pg::golomb::decoder_status::success )
+                {
+                    values.push_back( value );
+                }
+            }
+        } );
+    }
+}
+
+template< typename InputValueT, typename OutputDataT >
+static void parallel_encode( std::FILE * const in_file,
+                             std::FILE * const out_file,
+                             size_t k,
+                             int adaptive,
+                             int jobs,
+                             pg::golomb::codec_stats * stats )
+{
+    const auto n_blocks = static_cast< size_t >( jobs ) * blocks_per_job;
+
+    binary_input_file< InputValueT >          input( in_file, n_blocks * block_size );
+    std::vector< std::vector< OutputDataT > > blocks( n_blocks );
+    std::vector< pg::golomb::codec_stats >    block_stats( stats ? n_blocks : 0u );
+
+    for( auto values = input.read() ; !values.empty() ; values = input.read() )
+    {
+        const auto n_read_blocks = ( values.size() + block_size - 1u ) / block_size;
+
+        run_parallel( jobs, n_read_blocks, [ & ]( size_t i )
+        {
+            const auto first = i * block_size;
+            const auto count = std::min( block_size, values.size() - first );
+
+            encode_block( values.subspan( first, count ), blocks[ i ], k, adaptive, stats ? &block_stats[ i ] : nullptr );
+        } );
+
+        for( size_t i = 0u ; i < n_read_blocks ; ++i )
+        {
+            write_block( out_file, blocks[ i ] );
+        }
+    }
+
+    for( const auto & s : block_stats )
+    {
+        *stats += s;
+    }
+}
+
+template< typename OutputValueT >
+static void parallel_decode( std::FILE * const in_file,
+                             std::FILE * const out_file,
                              size_t k,
-                             int adaptive )
+                             int adaptive,
+                             int jobs,
+                             pg::golomb::codec_stats * stats )
+{
+    const auto n_blocks = static_cast< size_t >( jobs ) * blocks_per_job;
+
+    std::vector< std::vector< uint8_t > >      blocks( n_blocks );
+    std::vector< std::vector< OutputValueT > > values( n_blocks );
+    std::vector< pg::golomb::codec_stats >     block_stats( stats ? n_blocks : 0u );
+
+    for( size_t n_read_blocks = n_blocks ; n_read_blocks == n_blocks ; )
+    {
+        n_read_blocks = 0u;
+        while( n_read_blocks < n_blocks && read_block( in_file, blocks[ n_read_blocks ] ) )
+        {
+            ++n_read_blocks;
+        }
+
+        run_parallel( jobs, n_read_blocks, [ & ]( size_t i )
+        {
+            decode_block( blocks[ i ], values[ i ], k, adaptive, stats ? &block_stats[ i ] : nullptr );
+        } );
+
+        for( size_t i = 0u ; i < n_read_blocks ; ++i )
+        {
+            if( std::fwrite( values[ i ].data(), sizeof( OutputValueT ), values[ i ].size(), out_file ) != values[ i ].size() )
+            {
+                golomb_errno( "Output" );
+            }
+        }
+    }
+
+    for( const auto & s : block_stats )
+    {
+        *stats += s;
+    }
+}
+
+// Parallel stream mode
+
+constexpr size_t segment_size = 1u << 20;   // Size in bytes of the segments of a stream that are decoded in parallel
+constexpr size_t sync_bits    = 1u << 16;   // Number of bits at the begin of a segment of which the codeword starts are recorded
+
+// Start of a codeword and the number of values and zero overflows that are decoded before it in the segment.
+struct codeword_start
+{
+    size_t bit;
+    size_t values;
+    size_t zero_overflows;
+};
+
+// Part of a stream that is decoded speculatively from the begin of its first word.
+// The codeword that is decoded first probably doesn't start there, but the codewords that follow soon start at the
+// same bits as when the stream is decoded from its begin.
+template< typename InputDataT, typename OutputValueT >
+struct stream_segment
+{
+    using DecoderT = pg::golomb::decoder< const InputDataT * >;
+
+    DecoderT                      d              = DecoderT( nullptr, nullptr );  // Decoder after the last value of the segment
+    size_t                        offset         = {};  // Bit position in the stream of the begin of the decoder's input
+    std::vector< OutputValueT >   values;
+    size_t                        zero_overflows = {};
+    std::vector< codeword_start > starts;               // Codeword starts in the stream at the begin of the segment
+};
+
+// Decodes values from 'd' until it reaches bit position 'end' in the stream or the end of the data.
+template< typename OutputValueT, typename DecoderT >
+GOLOMB_HOT_FUNCTION
+static void decode_until( DecoderT & d,
+                          size_t offset,
+                          size_t end,
+                          std::vector< OutputValueT > & values,
+                          size_t & zero_overflows,
+                          size_t k )
+{
+    using UnsignedOutputValueT = std::make_unsigned< OutputValueT >::type;
+
+    constexpr auto value_digits = static_cast< size_t >( std::numeric_limits< UnsignedOutputValueT >::digits );
+
+    constexpr size_t max_batch = 65536u;
+
+    // The values of a batch don't pass 'end' when all have the longest codeword
+    const auto max_length = 2u * value_digits + 1u - std::min( k, value_digits - 1u );
+
+    for( auto position = offset + d.bit_position() ; position < end ; position = offset + d.bit_position() )
+    {
+        const auto count = values.size();
+        const auto n     = std::clamp( ( end - position ) / max_length, size_t{ 1u }, max_batch );
+
+        values.resize( count + n );
+
+        const auto result = d.template pull_n< OutputValueT >( std::span< OutputValueT >( values.data() + count, n ), k );
+
+        values.resize( count + result.count );
+        if( result.status == pg::golomb::decoder_status::zero_overflow )
+        {
+            ++zero_overflows;
+        }
+        else if( result.status == pg::golomb::decoder_status::done )
+        {
+            return;
+        }
+    }
+}
+
+// Decodes a segment of 'data' that starts at word 'first' until the codeword that passes bit position 'end'.
+// The codeword starts at the begin of the segment are recorded when 'record' is set.
+template< typename InputDataT, typename OutputValueT >
+static void decode_segment( std::span< const InputDataT > data,
+                            size_t first,
+                            size_t end,
+                            bool record,
+                            stream_segment< InputDataT, OutputValueT > & segment,
+                            size_t k )
+{
+    using DecoderT = typename stream_segment< InputDataT, OutputValueT >::DecoderT;
+
+    segment.d              = DecoderT( data.data() + first, data.data() + data.size() );
+    segment.offset         = first * std::numeric_limits< InputDataT >::digits;
+    segment.zero_overflows = 0u;
+    segment.values.clear();
+    segment.starts.clear();
+
+    const auto record_end = std::min( end, segment.offset + sync_bits );
+
+    for( auto position = segment.offset ; record && position < record_end ; position = segment.offset + segment.d.bit_position() )
+    {
+        segment.starts.push_back( { position, segment.values.size(), segment.zero_overflows } );
+
+        const auto [ value, status ] = segment.d.template pull< OutputValueT >( k );
+        if( status == pg::golomb::decoder_status::success )
+        {
+            segment.values.push_back( value );
+        }
+        else if( status == pg::golomb::decoder_status::zero_overflow )
+        {
+            ++segment.zero_overflows;
+        }
+        else
+        {
+            return;
+        }
+    }
+
+    decode_until( segment.d, segment.offset, end, segment.values, segment.zero_overflows, k );
+}
+
+// Fixes the begin of 'segment' which starts where the decoder 'd' of the previous segment stopped.
+// The values are decoded with 'd' until its position matches the start of a codeword of the segment, then the
+// speculatively decoded values that overlap the previous segment are replaced. When no start matches the whole
+// segment is decoded again.
+template< typename InputDataT, typename OutputValueT, typename DecoderT >
+static void fix_segment( stream_segment< InputDataT, OutputValueT > & segment,
+                         DecoderT d,
+                         size_t offset,
+                         size_t end,
+                         size_t k )
+{
+    std::vector< OutputValueT > values;
+    size_t                      zero_overflows = {};
+
+    for( auto start = segment.starts.cbegin() ; start != segment.starts.cend() ; )
+    {
+        const auto position = offset + d.bit_position();
+
+        start = std::find_if( start, segment.starts.cend(), [ position ]( const codeword_start & s ) { return s.bit >= position; } );
+        if( start != segment.starts.cend() && start->bit == position )
+        {
+            segment.values.erase( segment.values.begin(), segment.values.begin() + static_cast< std::ptrdiff_t >( start->values ) );
+            segment.values.insert( segment.values.begin(), values.cbegin(), values.cend() );
+            segment.zero_overflows += zero_overflows - start->zero_overflows;
+
+            return;
+        }
+
+        if( position >= end )
+        {
+            break;
+        }
+
+        const auto [ value, status ] = d.template pull< OutputValueT >( k );
+        if( status == pg::golomb::decoder_status::success )
+        {
+            values.push_back( value );
+        }
+        else if( status == pg::golomb::decoder_status::zero_overflow )
+        {
+            ++zero_overflows;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    decode_until( d, offset, end, values, zero_overflows, k );
+
+    segment.d              = d;
+    segment.offset         = offset;
+    segment.values         = std::move( values );
+    segment.zero_overflows = zero_overflows;
+}
+
+template< typename InputDataT, typename OutputValueT >
+static void parallel_stream_decode( std::FILE * const in_file,
+                                    std::FILE * const out_file,
+                                    size_t k,
+                                    int jobs,
+                                    pg::golomb::codec_stats * stats )
+{
+    using SegmentT = stream_segment< InputDataT, OutputValueT >;
+
+    const mapped_file mapping( in_file );
+    const auto        data = mapping.template values< InputDataT >();
+
+    if( data.empty() )
+    {
+        // The input is not a regular file
+        return stream_decode< InputDataT, OutputValueT >( in_file, out_file, k, -1, stats );
+    }
+
+    constexpr auto data_digits   = static_cast< size_t >( std::numeric_limits< InputDataT >::digits );
+    constexpr auto segment_words = segment_size / sizeof( InputDataT );
+
+    const auto n_segments = ( data.size() + segment_words - 1u ) / segment_words;
+    const auto n_parallel = std::min( n_segments, static_cast< size_t >( jobs ) * blocks_per_job );
+
+    binary_output_file< OutputValueT > output( out_file );
+    std::vector< SegmentT >            segments( n_parallel );
+    typename SegmentT::DecoderT        previous( nullptr, nullptr );  // Decoder after the last value that is written
+    size_t                             previous_offset = {};
+
+    // Bit position in the stream where the segment after 'i' starts
+    const auto segment_end = [ & ]( size_t i )
+    {
+        return i + 1u < n_segments ? ( i + 1u ) * segment_words * data_digits : std::numeric_limits< size_t >::max();
+    };
+
+    for( size_t first = 0u ; first < n_segments ; first += n_parallel )
+    {
+        const auto n = std::min( n_parallel, n_segments - first );
+
+        run_parallel( jobs, n, [ & ]( size_t i )
+        {
+            decode_segment( data, ( first + i ) * segment_words, segment_end( first + i ), first + i > 0u, segments[ i ], k );
+        } );
+
+        for( size_t i = 0u ; i < n ; ++i )
+        {
+            auto & segment = segments[ i ];
+
+            if( first + i > 0u )
+            {
+                fix_segment( segment, previous, previous_offset, segment_end( first + i ), k );
+            }
+
+            previous        = segment.d;
+            previous_offset = segment.offset;
+
+            output.write( std::span< const OutputValueT >( segment.values ) );
+
+            if( stats )
+            {
+                for( const auto value : segment.values )
+                {
+                    stats->count( value, k );
+                }
+
+                stats->zero_overflows += segment.zero_overflows;
+            }
+        }
+    }
+
+    output.flush();
+}
+
+// Frame mode
+
+constexpr size_t sample_windows     = 16u;     // Number of windows of consecutive values that are sampled by '-k auto'
+constexpr size_t sample_window_size = 4096u;   // Number of values in a sample window
+
+// Chooses the order with which a sample of 'values' is encoded with the least bits; in adaptive mode also the
+// filter shift. The sample consists of windows that are spread evenly over the values.
+template< typename InputValueT >
+static void choose_order( std::span< const InputValueT > values, uint8_t & k, int8_t & adaptive )
 {
     using UnsignedInputValueT = std::make_unsigned< InputValueT >::type;
-    if( adaptive >= std::numeric_limits< UnsignedInputValueT >::digits )
+
+    constexpr auto value_digits = std::numeric_limits< UnsignedInputValueT >::digits;
+
+    std::vector< InputValueT > sample;
+    if( values.size() <= sample_windows * sample_window_size )
     {
-        golomb_argument_error( "Invalid argument for option 'a'." );
+        sample.assign( values.begin(), values.end() );
+    }
+    else
+    {
+        const auto stride = values.size() / sample_windows;
+        for( size_t i = 0u ; i < sample_windows ; ++i )
+        {
+            const auto window = values.subspan( i * stride, sample_window_size );
+
+            sample.insert( sample.end(), window.begin(), window.end() );
+        }
     }
 
-    auto input = binary_input_file_iterator< InputValueT >( in_file );
-    auto last  = binary_input_file_iterator< InputValueT >();
+    const auto bits = pg::golomb::encoded_bits_by_order( sample );
 
-    using OutputItT = binary_output_file_iterator< OutputDataT >;
-    auto output     = OutputItT( out_file );
+    k = static_cast< uint8_t >( std::ranges::min_element( bits ) - bits.begin() );
+
+    if( adaptive >= 0 )
+    {
+        // The filter starts at the best fixed order
+        size_t best_bits = std::numeric_limits< size_t >::max();
+        for( int shift = 0 ; shift < value_digits ; ++shift )
+        {
+            const auto adaptive_bits = pg::golomb::adaptive_encoded_bits( sample, pg::golomb::ema_policy< pg::golomb::dynamic_shift >( k, static_cast< size_t >( shift ) ) );
+            if( adaptive_bits < best_bits )
+            {
+                adaptive  = static_cast< int8_t >( shift );
+                best_bits = adaptive_bits;
+            }
+        }
+    }
+}
+
+// Encodes all values in memory, so that the header with the number of values and the checksum of the encoded
+// data can be written in front of it. With order 'auto_order' the order and the adaptive mode are chosen with a sample
+// of the input; the whole input when it is mapped in memory, otherwise its first chunk.
+template< typename InputValueT, typename OutputDataT >
+GOLOMB_HOT_FUNCTION
+static void frame_encode( std::FILE * const in_file,
+                          std::FILE * const out_file,
+                          size_t k,
+                          int adaptive,
+                          pg::golomb::codec_stats * stats )
+{
+    using UnsignedInputValueT = std::make_unsigned< InputValueT >::type;
+    using BufferT             = pg::golomb::chunked_buffer< OutputDataT >;
+    using OutputItT           = typename BufferT::append_iterator;
+
+    constexpr auto value_digits = std::numeric_limits< UnsignedInputValueT >::digits;
+
+    binary_input_file< InputValueT > input( in_file );
+    BufferT                          buffer;
+    pg::golomb::frame_header         header;
+
+    header.value_digits = static_cast< uint8_t >( value_digits );
+    header.value_signed = std::is_signed_v< InputValueT >;
+    header.word_digits  = static_cast< uint8_t >( std::numeric_limits< OutputDataT >::digits );
+    header.k            = static_cast< uint8_t >( std::min< size_t >( k, value_digits - 1 ) );
+    header.adaptive     = static_cast< int8_t >( adaptive );
+
+    const auto first_values = input.read();
+    if( k == auto_order )
+    {
+        const auto mapped = input.mapped();
+
+        choose_order( mapped.empty() ? first_values : mapped, header.k, header.adaptive );
+        if( stats )
+        {
+            std::fprintf( stderr, "chosen order    %d, adaptive mode %d\n", header.k, header.adaptive );
+        }
+    }
+
+    if( header.adaptive >= 0 )
+    {
+        pg::golomb::adaptive_encoder< OutputItT, pg::golomb::dynamic_shift, OutputDataT > e{ buffer.appender(), header.k, static_cast< size_t >( header.adaptive ) };
+
+        with_stats< pg::golomb::stats_encoder >( e, stats, [ & ]( auto & e )
+        {
+            for( auto values = first_values ; !values.empty() ; values = input.read() )
+            {
+                for( const auto value : values )
+                {
+                    e.push( value );
+                }
+
+                header.count += values.size();
+            }
+
+            buffer.commit( e.flush() );
+        } );
+    }
+    else
+    {
+        pg::golomb::encoder< OutputItT, OutputDataT > e{ buffer.appender() };
+
+        with_stats< pg::golomb::stats_encoder >( e, stats, [ & ]( auto & e )
+        {
+            for( auto values = first_values ; !values.empty() ; values = input.read() )
+            {
+                for( const auto value : values )
+                {
+                    e.push( value, header.k );
+                }
+
+                header.count += values.size();
+            }
+
+            buffer.commit( e.flush() );
+        } );
+    }
+
+    for( const auto chunk : buffer.chunks() )
+    {
+        header.crc = pg::golomb::crc32c( std::as_bytes( chunk ), header.crc );
+    }
+
+    header.size = buffer.size() * sizeof( OutputDataT );
+
+    const auto header_data = pg::golomb::write_frame_header( header );
+    if( std::fwrite( header_data.data(), 1, header_data.size(), out_file ) != header_data.size() )
+    {
+        golomb_errno( "Output" );
+    }
+
+    for( const auto chunk : buffer.chunks() )
+    {
+        if( std::fwrite( chunk.data(), sizeof( OutputDataT ), chunk.size(), out_file ) != chunk.size() )
+        {
+            golomb_errno( "Output" );
+        }
+    }
+}
+
+// Decodes the number of values of the frame header from the encoded data of the frame.
+template< typename OutputValueT >
+GOLOMB_HOT_FUNCTION
+static void frame_decode( std::span< const uint8_t > data,
+                          const pg::golomb::frame_header & header,
+                          std::FILE * const out_file,
+                          pg::golomb::codec_stats * stats )
+{
+    using UnsignedOutputValueT = std::make_unsigned< OutputValueT >::type;
+
+    if( header.adaptive >= std::numeric_limits< UnsignedOutputValueT >::digits )
+    {
+        golomb_argument_error( "Input: invalid adaptive mode in the frame header." );
+    }
+
+    binary_output_file< OutputValueT > output( out_file );
+
+    // The values are decoded in the buffers of 'output' until the count of the header is reached
+    const auto write_count = [ & ]( const auto & pull_n )
+    {
+        for( auto remaining = header.count ; remaining > 0u ; )
+        {
+            const auto space  = output.space();
+            const auto result = pull_n( space.first( static_cast< size_t >( std::min< uint64_t >( space.size(), remaining ) ) ) );
+            if( result.status == pg::golomb::decoder_status::done )
+            {
+                golomb_argument_error( "Input: the frame holds less values than its header." );
+            }
+
+            output.commit( result.count );
+            remaining -= result.count;
+        }
+    };
+
+    const auto first = data.data();
+    const auto last  = data.data() + data.size();
+
+    if( header.adaptive >= 0 )
+    {
+        pg::golomb::adaptive_decoder< const uint8_t *, pg::golomb::dynamic_shift > d( first, last, header.k, static_cast< size_t >( header.adaptive ) );
+
+        with_stats< pg::golomb::stats_decoder >( d, stats, [ & ]( auto & d )
+        {
+            write_count( [ & ]( std::span< OutputValueT > values ) { return d.template pull_n< OutputValueT >( values ); } );
+        } );
+    }
+    else
+    {
+        pg::golomb::decoder d( first, last );
+
+        with_stats< pg::golomb::stats_decoder >( d, stats, [ & ]( auto & d )
+        {
+            write_count( [ & ]( std::span< OutputValueT > values ) { return d.template pull_n< OutputValueT >( values, header.k ); } );
+        } );
+    }
+
+    output.flush();
+}
+
+// Returns the data type of the values in a frame.
+[[nodiscard]] static data_type frame_data_type( const pg::golomb::frame_header & header ) noexcept
+{
+    switch( header.value_digits )
+    {
+    case 8:
+        return header.value_signed ? data_type::int8 : data_type::uint8;
+    case 16:
+        return header.value_signed ? data_type::int16 : data_type::uint16;
+    case 32:
+        return header.value_signed ? data_type::int32 : data_type::uint32;
+    case 64:
+        return header.value_signed ? data_type::int64 : data_type::uint64;
+    }
+
+    golomb_argument_error( "Input: unsupported value type in the frame header." );
+
+    return data_type::uint8;
+}
+
+// Reads a frame, checks its data with the checksum and decodes it. The format, order and adaptive mode are taken
+// from the frame header. Returns the data type of the decoded values.
+static data_type frame_decode( std::FILE * const in_file,
+                               std::FILE * const out_file,
+                               pg::golomb::codec_stats * stats )
+{
+    const mapped_file                                   mapping( in_file );
+    std::array< uint8_t, pg::golomb::frame_header_size > header_data;
+    std::vector< uint8_t >                              buffer;
+
+    auto data = mapping.values< uint8_t >();
+    if( data.empty() )
+    {
+        const auto size = std::fread( header_data.data(), 1, header_data.size(), in_file );
+        if( std::ferror( in_file ) )
+        {
+            golomb_errno( "Input" );
+        }
+
+        data = std::span< const uint8_t >( header_data ).first( size );
+    }
+
+    const auto [ header, status ] = pg::golomb::read_frame_header( data );
+    switch( status )
+    {
+    case pg::golomb::frame_status::valid:
+        break;
+    case pg::golomb::frame_status::truncated:
+        golomb_argument_error( "Input: frame truncated." );
+        break;
+    case pg::golomb::frame_status::not_a_frame:
+        golomb_argument_error( "Input: not a frame." );
+        break;
+    case pg::golomb::frame_status::corrupt_header:
+        golomb_argument_error( "Input: corrupt frame header." );
+        break;
+    }
+
+    if( header.word_order != std::endian::big && header.word_digits != 8u )
+    {
+        golomb_argument_error( "Input: the frame holds words in little endian byte order." );
+    }
+
+    // The encoded data is taken from the mapping or is read at once, its size is known from the header
+    if( !mapping.values< uint8_t >().empty() )
+    {
+        if( data.size() - pg::golomb::frame_header_size < header.size )
+        {
+            golomb_argument_error( "Input: frame truncated." );
+        }
+
+        data = data.subspan( pg::golomb::frame_header_size, static_cast< size_t >( header.size ) );
+    }
+    else
+    {
+        // The buffer grows with the data that is read, a corrupt size can't allocate more than the input holds
+        constexpr size_t read_size = 1u << 20;
+
+        for( uint64_t remaining = header.size ; remaining ; )
+        {
+            const auto size    = buffer.size();
+            const auto n_bytes = static_cast< size_t >( std::min< uint64_t >( remaining, read_size ) );
+
+            buffer.resize( size + n_bytes );
+            if( std::fread( buffer.data() + size, 1, n_bytes, in_file ) != n_bytes )
+            {
+                if( std::ferror( in_file ) )
+                {
+                    golomb_errno( "Input" );
+                }
+
+                golomb_argument_error( "Input: frame truncated." );
+            }
+
+            remaining -= n_bytes;
+        }
+
+        data = buffer;
+    }
 
-    pg::golomb::encoder< OutputItT, OutputDataT > e( output );
+    if( pg::golomb::crc32c( std::as_bytes( data ) ) != header.crc )
+    {
+        golomb_argument_error( "Input: checksum mismatch of the frame data." );
+    }
 
-    for( ; input != last ; ++input )
+    const auto type = frame_data_type( header );
+    switch( type )
     {
-        const auto unsigned_value = pg::golomb::to_unsigned( *input );
+    case data_type::int8:
+        frame_decode< int8_t >( data, header, out_file, stats );
+        break;
+
+    case data_type::uint8:
+        frame_decode< uint8_t >( data, header, out_file, stats );
+        break;
+
+    case data_type::int16:
+        frame_decode< int16_t >( data, header, out_file, stats );
+        break;
+
+    case data_type::uint16:
+        frame_decode< uint16_t >( data, header, out_file, stats );
+        break;
+
+    case data_type::int32:
+        frame_decode< int32_t >( data, header, out_file, stats );
+        break;
+
+    case data_type::uint32:
+        frame_decode< uint32_t >( data, header, out_file, stats );
+        break;
 
-        e.push( unsigned_value, k );
+    case data_type::int64:
+        frame_decode< int64_t >( data, header, out_file, stats );
+        break;
 
-        k = k - ( k >> adaptive ) + ( std::bit_width( unsigned_value ) >> adaptive );
+    case data_type::uint64:
+        frame_decode< uint64_t >( data, header, out_file, stats );
+        break;
     }
 
-    e.flush();
+    return type;
 }
 
 template< typename InputValueT, typename OutputDataT >
 static void encode( std::FILE * const in_file,
                     std::FILE * const out_file,
                     size_t k,
-                    int adaptive )
+                    int adaptive,
+                    int jobs,
+                    bool framed,
+                    pg::golomb::codec_stats * stats )
 {
-    if( adaptive >= 0 )
+    using UnsignedInputValueT = std::make_unsigned< InputValueT >::type;
+
+    if( adaptive >= std::numeric_limits< UnsignedInputValueT >::digits )
+    {
+        golomb_argument_error( "Invalid argument for option 'a'." );
+    }
+
+    if( framed )
+    {
+        frame_encode< InputValueT, OutputDataT >( in_file, out_file, k, adaptive, stats );
+    }
+    else if( jobs > 0 )
     {
-        adaptive_encode< InputValueT, OutputDataT >( in_file, out_file, k, adaptive );
+        parallel_encode< InputValueT, OutputDataT >( in_file, out_file, k, adaptive, jobs, stats );
     }
     else
     {
-        pg::golomb::encode( binary_input_file< InputValueT >( in_file ),
-                            binary_output_file_iterator< OutputDataT >( out_file ),
-                            k );
+        stream_encode< InputValueT, OutputDataT >( in_file, out_file, k, adaptive, stats );
+    }
+}
+
+template< typename InputValueT >
+static void encode( std::FILE * const in_file,
+                    std::FILE * const out_file,
+                    int word_bits,
+                    size_t k,
+                    int adaptive,
+                    int jobs,
+                    bool framed,
+                    pg::golomb::codec_stats * stats )
+{
+    switch( word_bits )
+    {
+    case 16:
+        return encode< InputValueT, uint16_t >( in_file, out_file, k, adaptive, jobs, framed, stats );
+
+    case 32:
+        return encode< InputValueT, uint32_t >( in_file, out_file, k, adaptive, jobs, framed, stats );
+
+    case 64:
+        return encode< InputValueT, uint64_t >( in_file, out_file, k, adaptive, jobs, framed, stats );
+
+    default:
+        return encode< InputValueT, uint8_t >( in_file, out_file, k, adaptive, jobs, framed, stats );
     }
 }
 
 static void encode( std::FILE * const in_file,
                     std::FILE * const out_file,
                     data_type type,
+                    int word_bits,
                     size_t k,
-                    int adaptive ) noexcept
+                    int adaptive,
+                    int jobs,
+                    bool framed,
+                    pg::golomb::codec_stats * stats ) noexcept
 {
     switch( type )
     {
     case data_type::int8:
-        return encode< int8_t, uint8_t >( in_file, out_file, k, adaptive );
+        return encode< int8_t >( in_file, out_file, word_bits, k, adaptive, jobs, framed, stats );
 
     case data_type::uint8:
-        return encode< uint8_t, uint8_t >( in_file, out_file, k, adaptive );
+        return encode< uint8_t >( in_file, out_file, word_bits, k, adaptive, jobs, framed, stats );
 
     case data_type::int16:
-        return encode< int16_t, uint8_t >( in_file, out_file, k, adaptive );
+        return encode< int16_t >( in_file, out_file, word_bits, k, adaptive, jobs, framed, stats );
 
     case data_type::uint16:
-        return encode< uint16_t, uint8_t >( in_file, out_file, k, adaptive );
+        return encode< uint16_t >( in_file, out_file, word_bits, k, adaptive, jobs, framed, stats );
 
     case data_type::int32:
-        return encode< int32_t, uint8_t >( in_file, out_file, k, adaptive );
+        return encode< int32_t >( in_file, out_file, word_bits, k, adaptive, jobs, framed, stats );
 
     case data_type::uint32:
-        return encode< uint32_t, uint8_t >( in_file, out_file, k, adaptive );
+        return encode< uint32_t >( in_file, out_file, word_bits, k, adaptive, jobs, framed, stats );
 
     case data_type::int64:
-        return encode< int64_t, uint8_t >( in_file, out_file, k, adaptive );
+        return encode< int64_t >( in_file, out_file, word_bits, k, adaptive, jobs, framed, stats );
 
     case data_type::uint64:
-        return encode< uint64_t, uint8_t >( in_file, out_file, k, adaptive );
+        return encode< uint64_t >( in_file, out_file, word_bits, k, adaptive, jobs, framed, stats );
     }
 }
 
 template< typename InputDataT, typename OutputValueT >
-static void adaptive_decode( std::FILE * const in_file,
-                             std::FILE * const out_file,
-                             size_t k,
-                             int adaptive )
+static void decode( std::FILE * const in_file,
+                    std::FILE * const out_file,
+                    size_t k,
+                    int adaptive,
+                    int jobs,
+                    int stream_jobs,
+                    pg::golomb::codec_stats * stats )
 {
     using UnsignedOutputValueT = std::make_unsigned< OutputValueT >::type;
 
@@ -526,72 +2117,130 @@ static void adaptive_decode( std::FILE * const in_file,
         golomb_argument_error( "Invalid argument for option 'a'." );
     }
 
-    auto input     = binary_input_file_iterator< InputDataT >( in_file );
-    auto input_end = binary_input_file_iterator< InputDataT >();
-    auto output    = binary_output_file_iterator< OutputValueT >( out_file );
-
-    pg::golomb::decoder d( input, input_end );
-
-    while( d.has_data() )
+    if( jobs > 0 )
     {
-        const auto [ value, status ] = d.template pull< UnsignedOutputValueT >( k );
-        if( status == pg::golomb::decoder_status::success )
-        {
-            k         = k - ( k >> adaptive ) + ( std::bit_width( value ) >> adaptive );
-            *output++ = pg::golomb::to_integral< OutputValueT >( value );
-        }
+        parallel_decode< OutputValueT >( in_file, out_file, k, adaptive, jobs, stats );
+    }
+    else if( stream_jobs > 0 )
+    {
+        parallel_stream_decode< InputDataT, OutputValueT >( in_file, out_file, k, stream_jobs, stats );
+    }
+    else
+    {
+        stream_decode< InputDataT, OutputValueT >( in_file, out_file, k, adaptive, stats );
     }
 }
 
-template< typename InputDataT, typename OutputValueT >
+template< typename OutputValueT >
 static void decode( std::FILE * const in_file,
                     std::FILE * const out_file,
+                    int word_bits,
                     size_t k,
-                    int adaptive )
+                    int adaptive,
+                    int jobs,
+                    int stream_jobs,
+                    pg::golomb::codec_stats * stats )
 {
-    if( adaptive >= 0 )
-    {
-        adaptive_decode< InputDataT, OutputValueT >( in_file, out_file, k, adaptive );
-    }
-    else
+    switch( word_bits )
     {
-        pg::golomb::decode< OutputValueT >( binary_input_file< InputDataT >( in_file ),
-                                            binary_output_file_iterator< OutputValueT >( out_file ),
-                                            k );
+    case 16:
+        return decode< uint16_t, OutputValueT >( in_file, out_file, k, adaptive, jobs, stream_jobs, stats );
+
+    case 32:
+        return decode< uint32_t, OutputValueT >( in_file, out_file, k, adaptive, jobs, stream_jobs, stats );
+
+    case 64:
+        return decode< uint64_t, OutputValueT >( in_file, out_file, k, adaptive, jobs, stream_jobs, stats );
+
+    default:
+        return decode< uint8_t, OutputValueT >( in_file, out_file, k, adaptive, jobs, stream_jobs, stats );
     }
 }
 
 static void decode( std::FILE * const in_file,
                     std::FILE * const out_file,
                     data_type type,
+                    int word_bits,
                     size_t k,
-                    int adaptive ) noexcept
+                    int adaptive,
+                    int jobs,
+                    int stream_jobs,
+                    pg::golomb::codec_stats * stats ) noexcept
 {
     switch( type )
     {
     case data_type::int8:
-        return decode< uint8_t, int8_t >( in_file, out_file, k, adaptive );
+        return decode< int8_t >( in_file, out_file, word_bits, k, adaptive, jobs, stream_jobs, stats );
 
     case data_type::uint8:
-        return decode< uint8_t, uint8_t >( in_file, out_file, k, adaptive );
+        return decode< uint8_t >( in_file, out_file, word_bits, k, adaptive, jobs, stream_jobs, stats );
 
     case data_type::int16:
-        return decode< uint8_t, int16_t >( in_file, out_file, k, adaptive );
+        return decode< int16_t >( in_file, out_file, word_bits, k, adaptive, jobs, stream_jobs, stats );
 
     case data_type::uint16:
-        return decode< uint8_t, uint16_t >( in_file, out_file, k, adaptive );
+        return decode< uint16_t >( in_file, out_file, word_bits, k, adaptive, jobs, stream_jobs, stats );
 
     case data_type::int32:
-        return decode< uint8_t, int32_t >( in_file, out_file, k, adaptive );
+        return decode< int32_t >( in_file, out_file, word_bits, k, adaptive, jobs, stream_jobs, stats );
 
     case data_type::uint32:
-        return decode< uint8_t, uint32_t >( in_file, out_file, k, adaptive );
+        return decode< uint32_t >( in_file, out_file, word_bits, k, adaptive, jobs, stream_jobs, stats );
 
     case data_type::int64:
-        return decode< uint8_t, int64_t >( in_file, out_file, k, adaptive );
+        return decode< int64_t >( in_file, out_file, word_bits, k, adaptive, jobs, stream_jobs, stats );
+
+    case data_type::uint64:
+        return decode< uint64_t >( in_file, out_file, word_bits, k, adaptive, jobs, stream_jobs, stats );
+    }
+}
+
+[[nodiscard]] static size_t value_size( data_type type ) noexcept
+{
+    switch( type )
+    {
+    case data_type::int8:
+    case data_type::uint8:
+        return 1u;
+
+    case data_type::int16:
+    case data_type::uint16:
+        return 2u;
+
+    case data_type::int32:
+    case data_type::uint32:
+        return 4u;
 
+    case data_type::int64:
     case data_type::uint64:
-        return decode< uint8_t, uint64_t >( in_file, out_file, k, adaptive );
+        break;
+    }
+
+    return 8u;
+}
+
+// Prints the statistics, the wall time and the throughput of the values to the standard error.
+static void print_stats( const pg::golomb::codec_stats & stats, size_t value_bytes, double seconds )
+{
+    const auto values    = static_cast< double >( stats.values );
+    const auto raw_bytes = values * static_cast< double >( value_bytes );
+
+    std::fprintf( stderr, "values          %zu\n", stats.values );
+    std::fprintf( stderr, "encoded bits    %zu, %.3f bits/value, ratio %.3f\n", stats.bits,
+                  stats.values ? static_cast< double >( stats.bits ) / values : 0.0,
+                  stats.values ? static_cast< double >( stats.bits ) / ( 8.0 * raw_bytes ) : 0.0 );
+    std::fprintf( stderr, "flushes         %zu\n", stats.flushes );
+    std::fprintf( stderr, "zero overflows  %zu\n", stats.zero_overflows );
+    std::fprintf( stderr, "order changes   %zu\n", stats.order_changes );
+    std::fprintf( stderr, "time            %.3f s, %.1f MB/s\n", seconds, seconds > 0.0 ? raw_bytes / seconds / 1e6 : 0.0 );
+    std::fprintf( stderr, "prefix zeros    codewords\n" );
+
+    for( size_t zeros = 0u ; zeros < stats.zeros.size() ; ++zeros )
+    {
+        if( stats.zeros[ zeros ] )
+        {
+            std::fprintf( stderr, "%15zu %11zu %6.2f %%\n", zeros, stats.zeros[ zeros ], 100.0 * static_cast< double >( stats.zeros[ zeros ] ) / values );
+        }
     }
 }
 
@@ -599,10 +2248,15 @@ int main( const int argc, const char * argv[] )
 {
     enum transformation : char { encode_ = 'e', decode_ = 'd' };
 
-    transformation   direction = transformation::encode_;
-    data_type        type      = data_type::uint8;
-    size_t           k         = {};
-    int              adaptive  = -1;
+    transformation   direction   = transformation::encode_;
+    data_type        type        = data_type::uint8;
+    size_t           k           = {};
+    int              adaptive    = -1;
+    int              jobs        = {};
+    int              stream_jobs = {};
+    bool             framed      = false;
+    bool             verbose     = false;
+    int              word_bits   = 8;
     std::string_view input;
     std::string_view output;
 
@@ -626,14 +2280,34 @@ int main( const int argc, const char * argv[] )
                 type      = decode_format_arg( opt, opts.read_argument() );
                 break;
 
+            case 'f':
+                framed = true;
+                break;
+
             case 'h':
                 print_help();
                 break;
 
+            case 'j':
+                jobs = decode_jobs_arg( 'j', opts.read_argument() );
+                break;
+
             case 'k':
                 k = decode_k_arg( opts.read_argument() );
                 break;
 
+            case 'p':
+                stream_jobs = decode_jobs_arg( 'p', opts.read_argument() );
+                break;
+
+            case 'v':
+                verbose = true;
+                break;
+
+            case 'w':
+                word_bits = decode_word_size_arg( opts.read_argument() );
+                break;
+
             default:
                 golomb_argument_error( "Unrecognized option '%c'.", opt );
             }
@@ -643,6 +2317,26 @@ int main( const int argc, const char * argv[] )
         output = opts.read_argument();
     }
 
+    if( stream_jobs && ( direction != transformation::decode_ || adaptive >= 0 || jobs ) )
+    {
+        golomb_argument_error( "Option 'p' can only be used to decode without adaptive mode and block mode." );
+    }
+
+    if( k == auto_order )
+    {
+        if( direction != transformation::encode_ )
+        {
+            golomb_argument_error( "Option 'k' with argument 'auto' can only be used to encode." );
+        }
+
+        framed = true;
+    }
+
+    if( framed && ( jobs || stream_jobs ) )
+    {
+        golomb_argument_error( "Option 'f' cannot be combined with block mode and parallel stream decoding." );
+    }
+
     if( input.empty() )
     {
         golomb_argument_error( "No input input parameter provided." );
@@ -665,13 +2359,28 @@ int main( const int argc, const char * argv[] )
         golomb_errno( "Output" );
     }
 
+    pg::golomb::codec_stats stats;
+
+    const auto start = std::chrono::steady_clock::now();
+
     if( direction == transformation::encode_ )
     {
-        encode( in_file, out_file, type, k, adaptive );
+        encode( in_file, out_file, type, word_bits, k, adaptive, jobs, framed, verbose ? &stats : nullptr );
+    }
+    else if( framed )
+    {
+        type = frame_decode( in_file, out_file, verbose ? &stats : nullptr );
     }
     else
     {
-        decode( in_file, out_file, type, k, adaptive );
+        decode( in_file, out_file, type, word_bits, k, adaptive, jobs, stream_jobs, verbose ? &stats : nullptr );
+    }
+
+    if( verbose )
+    {
+        const std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+
+        print_stats( stats, value_size( type ), elapsed.count() );
     }
 
     return 0;